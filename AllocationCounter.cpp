@@ -0,0 +1,65 @@
+#include "AllocationCounter.h"
+
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+static thread_local uint64_t threadAllocationCount = 0;
+
+uint64_t getThreadAllocationCount()
+{
+	return threadAllocationCount;
+}
+
+// array & nothrow forms forward to these by default
+void* operator new(std::size_t size)
+{
+	threadAllocationCount++;
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	threadAllocationCount++;
+	const std::size_t alignValue = std::size_t(alignment);
+#ifdef _MSC_VER
+	void* memory = _aligned_malloc(size == 0 ? 1 : size, alignValue);
+#else
+	// aligned_alloc requires size to be a multiple of alignment
+	void* memory = std::aligned_alloc(alignValue, (size + alignValue - 1) / alignValue * alignValue);
+#endif
+	if (memory)
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+#ifdef _MSC_VER
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+// debug builds replace global operator new to count heap allocations,
+// used to verify the parsing hot loop stays allocation free
+#ifndef NDEBUG
+#define OBJANALYZER_COUNT_ALLOCATIONS 1
+#endif
+
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+// number of allocations made by the calling thread so far
+uint64_t getThreadAllocationCount();
+#endif
@@ -0,0 +1,638 @@
+#include "Benchmark.h"
+
+BenchmarkCorpusGenerator::BenchmarkCorpusGenerator(const std::filesystem::path& outputDir, uint32_t scale) : outputDir(outputDir), scale(scale) {};
+
+BenchmarkCorpus BenchmarkCorpusGenerator::writeCorpus(std::string_view name, const std::function<void(std::string&)>& generate) const
+{
+	BenchmarkCorpus corpus;
+	corpus.name = name;
+	corpus.filepath = outputDir / (corpus.name + ".obj");
+
+	std::string data;
+	generate(data);
+	corpus.byteCount = data.size();
+	corpus.lineCount = std::ranges::count(data, '\n');
+
+	std::ofstream file(corpus.filepath, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), std::streamsize(data.size()));
+	return corpus;
+};
+
+void BenchmarkCorpusGenerator::generateDenseTris(std::string& data, uint32_t gridSize)
+{
+	auto out = std::back_inserter(data);
+	std::format_to(out, "# dense tri grid {0}x{0}\no grid\nusemtl grid_mat\n", gridSize);
+	for (uint32_t y = 0; y <= gridSize; y++)
+	{
+		for (uint32_t x = 0; x <= gridSize; x++)
+		{
+			std::format_to(out, "v {:.6f} {:.6f} {:.6f}\n", x * 0.01, y * 0.01, ((x * 7 + y * 13) % 100) * 0.001);
+			std::format_to(out, "vt {:.6f} {:.6f}\n", double(x) / gridSize, double(y) / gridSize);
+		}
+	}
+	for (uint32_t y = 0; y < gridSize; y++)
+	{
+		for (uint32_t x = 0; x < gridSize; x++)
+		{
+			const uint32_t i = y * (gridSize + 1) + x + 1;
+			const uint32_t j = i + gridSize + 1;
+			std::format_to(out, "f {0}/{0} {1}/{1} {2}/{2}\nf {0}/{0} {2}/{2} {3}/{3}\n", i, i + 1, j + 1, j);
+		}
+	}
+};
+
+void BenchmarkCorpusGenerator::generateNgonCad(std::string& data, uint32_t profileCount)
+{
+	auto out = std::back_inserter(data);
+	uint32_t vertIndex = 1;
+	for (uint32_t profile = 0; profile < profileCount; profile++)
+	{
+		// 3 to 16 sided caps joined by quads
+		const uint32_t sideCount = 3 + profile % 14;
+		std::format_to(out, "o part_{}\ng body\nusemtl steel_{}\n", profile, profile % 8);
+		for (uint32_t ring = 0; ring < 2; ring++)
+		{
+			for (uint32_t side = 0; side < sideCount; side++)
+			{
+				std::format_to(out, "v {:.4f} {:.4f} {:.4f}\n", double(profile) + side * 0.1, double(ring), side * 0.05);
+			}
+		}
+		for (uint32_t ring = 0; ring < 2; ring++)
+		{
+			data += 'f';
+			for (uint32_t side = 0; side < sideCount; side++)
+			{
+				std::format_to(out, " {}", vertIndex + ring * sideCount + side);
+			}
+			data += '\n';
+		}
+		data += "g sides\n";
+		for (uint32_t side = 0; side < sideCount; side++)
+		{
+			const uint32_t next = (side + 1) % sideCount;
+			std::format_to(out, "f {} {} {} {}\n", vertIndex + side, vertIndex + next, vertIndex + sideCount + next, vertIndex + sideCount + side);
+		}
+		vertIndex += sideCount * 2;
+	}
+};
+
+void BenchmarkCorpusGenerator::generateVertexColorScan(std::string& data, uint32_t pointCount)
+{
+	auto out = std::back_inserter(data);
+	data += "o scan\n";
+	for (uint32_t i = 0; i < pointCount; i++)
+	{
+		std::format_to(out, "v {:.6f} {:.6f} {:.6f} {:.4f} {:.4f} {:.4f}\nvn 0.0 0.0 1.0\n",
+			(i % 1000) * 0.001, (i / 1000) * 0.001, (i % 97) * 0.0001,
+			(i % 255) / 255.0, (i % 127) / 127.0, (i % 63) / 63.0);
+	}
+	// points reference vertices in batches
+	for (uint32_t i = 1; i + 8 <= pointCount; i += 8)
+	{
+		std::format_to(out, "p {} {} {} {} {} {} {} {}\n", i, i + 1, i + 2, i + 3, i + 4, i + 5, i + 6, i + 7);
+	}
+};
+
+void BenchmarkCorpusGenerator::generateTinyObjects(std::string& data, uint32_t objectCount)
+{
+	auto out = std::back_inserter(data);
+	for (uint32_t i = 0; i < objectCount; i++)
+	{
+		const uint32_t vertIndex = i * 3 + 1;
+		std::format_to(out, "o prop_{0}\nusemtl mat_{1}\nv {0} 0 0\nv {0} 1 0\nv {0} 0 1\nf {2} {3} {4}\n", i, i % 32, vertIndex, vertIndex + 1, vertIndex + 2);
+	}
+};
+
+void BenchmarkCorpusGenerator::generateMessyExport(std::string& data, uint32_t objectCount)
+{
+	auto out = std::back_inserter(data);
+	// elements before the first "o" line belong to the file's default collection
+	data += "v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\nf 1/1/1 2/1/1 3/1/1\n";
+	uint32_t vertCount = 3;
+	for (uint32_t i = 0; i < objectCount; i++)
+	{
+		if (i % 53 == 0)
+		{
+			data += "o\n";
+		}
+		else if (i % 71 == 0)
+		{
+			std::format_to(out, "o part_{0} extra_{0}\n", i);
+		}
+		else
+		{
+			std::format_to(out, "o part_{}\n", i);
+		}
+		if (i % 4 == 0)
+		{
+			std::format_to(out, "g {}\n", i % 29 == 0 ? "grp_a grp_b" : (i % 8 == 0 ? "grp_a" : "grp_b"));
+		}
+
+		for (uint32_t vert = 0; vert < 4; vert++)
+		{
+			// repeated positions across objects, so unique counts differ from vertex counts
+			std::format_to(out, "v {:.3f} {:.3f} {:.3f}\n", (i % 17) * 0.5, vert * 0.25, (i % 5) * 0.125);
+		}
+		if (i % 97 == 0)
+		{
+			data += "v 1.0 not_a_number 2.0\n";
+			vertCount++;
+		}
+		vertCount += 4;
+		data += "vt 0.5 0.5\nvn 0 1 0\n";
+
+		// relative indices, absolute ones into earlier objects & ones past the elements defined so far
+		data += "f -1/-1/-1 -2/-1/-1 -3/-1/-1 -4/-1/-1\n";
+		std::format_to(out, "f {} {} {}\n", vertCount, vertCount - 5, i % 3 == 0 ? 1 : vertCount - 2);
+		if (i % 13 == 0)
+		{
+			std::format_to(out, "f {} {} {}\n", vertCount, vertCount + 1, vertCount + 1000);
+			data += "f 1/999999 2//999999 3\n";
+		}
+	}
+};
+
+std::vector<BenchmarkCorpus> BenchmarkCorpusGenerator::generateAll() const
+{
+	std::filesystem::create_directories(outputDir);
+
+	// sizes picked so each corpus is ~10-20 MB at scale 1
+	return {
+		writeCorpus("dense_tris",    [this](std::string& data) { generateDenseTris(data, 300 * scale); }),
+		writeCorpus("ngon_cad",      [this](std::string& data) { generateNgonCad(data, 20'000 * scale); }),
+		writeCorpus("vcolor_scan",   [this](std::string& data) { generateVertexColorScan(data, 200'000 * scale); }),
+		writeCorpus("tiny_objects",  [this](std::string& data) { generateTinyObjects(data, 100'000 * scale); }),
+		writeCorpus("messy_export",  [this](std::string& data) { generateMessyExport(data, 100'000 * scale); }),
+	};
+};
+
+// --------------------------------
+BenchmarkRunner::BenchmarkRunner(uint32_t runCount) : runCount(runCount) {};
+
+void BenchmarkRunner::addResult(std::string_view name, const BenchmarkCorpus& corpus, uint64_t byteCount, uint64_t itemCount, std::string_view itemUnit, const std::function<void()>& run)
+{
+	BenchmarkResult& result = results.emplace_back();
+	result.name = name;
+	result.corpusName = corpus.name;
+	result.byteCount = byteCount;
+	result.itemCount = itemCount;
+	result.itemUnit = itemUnit;
+	result.bestTime = std::chrono::nanoseconds::max();
+
+	for (uint32_t i = 0; i < runCount; i++)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		run();
+		result.bestTime = std::min(result.bestTime, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime));
+	}
+};
+
+ProcessingSettings BenchmarkRunner::makeSettings(ProcessingMode mode, DataCollectionGrouping grouping)
+{
+	ProcessingSettings settings;
+	settings.mode = mode;
+	settings.grouping = grouping;
+
+	// check everything so every line type is relevant
+	for (ValidationBoolElem* elem : {
+		&settings.validations.containsVerts, &settings.validations.containsUvs, &settings.validations.containsVertexNormals,
+		&settings.validations.containsVertexColor, &settings.validations.containsLooseEdges, &settings.validations.containsLoosePoints,
+		&settings.validations.containsFaces, &settings.validations.containsTris, &settings.validations.containsQuads,
+		&settings.validations.containsNgons, &settings.validations.containsMaterials, &settings.validations.MissingName })
+	{
+		elem->shouldCheck = true;
+		elem->expectedValue = true;
+	}
+	for (BudgetUint32Elem* elem : {
+		&settings.budgets.verts, &settings.budgets.points, &settings.budgets.lines,
+		&settings.budgets.faceTotals, &settings.budgets.faceTris, &settings.budgets.faceQuads,
+		&settings.budgets.faceNgons, &settings.budgets.materials, &settings.budgets.groups })
+	{
+		elem->shouldCheck = true;
+		elem->value = 10'000;
+	}
+	return settings;
+};
+
+void BenchmarkRunner::runLineProcessorBenchmarks(const BenchmarkCorpus& corpus, std::string_view fileData)
+{
+	auto forEachLine = [fileData](auto&& func)
+		{
+			InputChunkReader reader(fileData);
+			LineProcessor lineProcessor;
+			while (reader.getLine(lineProcessor.line, lineProcessor.spaceCount))
+			{
+				func(lineProcessor);
+			}
+		};
+
+	addResult("LineProcessor::getLineType", corpus, corpus.byteCount, corpus.lineCount, "lines", [&]()
+		{
+			forEachLine([this](const LineProcessor& lineProcessor) { sink += uint64_t(lineProcessor.getLineType()); });
+		});
+	addResult("LineProcessor::getValueCount", corpus, corpus.byteCount, corpus.lineCount, "lines", [&]()
+		{
+			forEachLine([this](const LineProcessor& lineProcessor) { sink += lineProcessor.getValueCount(); });
+		});
+	addResult("LineProcessor::getValues", corpus, corpus.byteCount, corpus.lineCount, "lines", [&]()
+		{
+			forEachLine([this](const LineProcessor& lineProcessor)
+				{
+					for (std::string_view value : lineProcessor.getValues())
+					{
+						sink += value.size();
+					}
+				});
+		});
+};
+
+void BenchmarkRunner::runFileProcessorBenchmarks(const BenchmarkCorpus& corpus)
+{
+	static constexpr std::pair<DataCollectionGrouping, std::string_view> groupings[] =
+	{
+		{ DataCollectionGrouping::File,        "FileProcessor (file)" },
+		{ DataCollectionGrouping::Object,      "FileProcessor (object)" },
+		{ DataCollectionGrouping::Vertexgroup, "FileProcessor (group)" },
+	};
+
+	for (const auto& [grouping, name] : groupings)
+	{
+		const ProcessingSettings settings = makeSettings(ProcessingMode::Overview, grouping);
+		// reused across runs like the tool reuses it across files
+		FileArena fileArena;
+		addResult(name, corpus, corpus.byteCount, corpus.lineCount, "lines", [&]()
+			{
+				// captured & discarded, console output would dominate the timing
+				LogManager loggingManager;
+				loggingManager.enableCapture();
+				fileArena.release();
+				FileProcessor processor(corpus.filepath, settings, loggingManager, nullptr, &fileArena);
+				processor.processFile();
+				sink += processor.resultStore.size();
+			});
+	}
+};
+
+void BenchmarkRunner::runOutputterBenchmarks(const BenchmarkCorpus& corpus, const std::filesystem::path& csvDir)
+{
+	static constexpr std::pair<ProcessingMode, std::string_view> modes[] =
+	{
+		{ ProcessingMode::Overview, "ResultOutputterOverview" },
+		{ ProcessingMode::Validate, "ResultOutputterValidate" },
+		{ ProcessingMode::Budget,   "ResultOutputterBudget" },
+	};
+
+	for (const auto& [mode, name] : modes)
+	{
+		ProcessingSettings settings = makeSettings(mode, DataCollectionGrouping::Object);
+		settings.csvFilePath = csvDir / std::format("{}_{}.csv", corpus.name, name);
+
+		// collections to output, parsed once outside of the timed runs
+		LogManager processingLoggingManager;
+		processingLoggingManager.enableCapture();
+		FileProcessor processor(corpus.filepath, settings, processingLoggingManager);
+		processor.processFile();
+
+		uint64_t outputByteCount = 0;
+		addResult(name, corpus, 0, processor.resultStore.size(), "collections", [&]()
+			{
+				std::filesystem::remove(settings.csvFilePath);
+				LogManager loggingManager;
+				loggingManager.enableCapture();
+				{
+					std::unique_ptr<ResultOutputterBase> outputFormatter;
+					switch (mode)
+					{
+					case ProcessingMode::Overview: outputFormatter = std::make_unique<ResultOutputterOverview>(settings, loggingManager); break;
+					case ProcessingMode::Validate: outputFormatter = std::make_unique<ResultOutputterValidate>(settings, loggingManager); break;
+					case ProcessingMode::Budget:   outputFormatter = std::make_unique<ResultOutputterBudget>(settings, loggingManager); break;
+					}
+					PrimDataCollection asset{ std::string_view() };
+					for (size_t row = 0; row < processor.resultStore.size(); row++)
+					{
+						processor.resultStore.load(row, asset);
+						outputFormatter->outputReports(asset);
+					}
+					outputFormatter->flushCsv();
+				}
+				outputByteCount = loggingManager.takeCapturedLog().size() + std::filesystem::file_size(settings.csvFilePath);
+			});
+		// throughput of output reports is measured in bytes written
+		results.back().byteCount = outputByteCount;
+		std::filesystem::remove(settings.csvFilePath);
+	}
+};
+
+void BenchmarkRunner::run(const std::vector<BenchmarkCorpus>& corpora, const std::filesystem::path& csvDir)
+{
+	for (const BenchmarkCorpus& corpus : corpora)
+	{
+		std::ifstream file(corpus.filepath, std::ios::binary);
+		const std::string fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		runLineProcessorBenchmarks(corpus, fileData);
+		runFileProcessorBenchmarks(corpus);
+		runOutputterBenchmarks(corpus, csvDir);
+	}
+};
+
+std::string BenchmarkRunner::formatResults() const
+{
+	std::string table = std::format("{:<30} {:<14} {:>12} {:>12} {:>16}\n", "Benchmark", "Corpus", "Best (ms)", "MB/s", "Items/s");
+	table += std::string(88, '-') + '\n';
+
+	for (const BenchmarkResult& result : results)
+	{
+		const double seconds = std::chrono::duration<double>(result.bestTime).count();
+		std::format_to(std::back_inserter(table), "{:<30} {:<14} {:>12.2f} {:>12.1f} {:>16.0f} {}\n",
+			result.name,
+			result.corpusName,
+			seconds * 1000.0,
+			seconds > 0 ? result.byteCount / seconds / (1 << 20) : 0.0,
+			seconds > 0 ? result.itemCount / seconds : 0.0,
+			result.itemUnit
+		);
+	}
+	// printed so the sink can't be optimized away
+	std::format_to(std::back_inserter(table), "(checksum {})\n", sink);
+	return table;
+};
+
+// --------------------------------
+void CorpusChecker::addResult(std::string_view corpusName, std::string_view checkName, std::string_view failure, std::string_view note)
+{
+	std::format_to(std::back_inserter(report), "{:<14} {:<36} {}\n", corpusName, checkName, failure.empty() ? note : failure);
+	if (!failure.empty())
+	{
+		failureCount++;
+	}
+};
+
+ProcessingSettings CorpusChecker::makeSettings(DataCollectionGrouping grouping)
+{
+	ProcessingSettings settings;
+	settings.mode = ProcessingMode::Overview;
+	settings.grouping = grouping;
+	// every analysis that is merged across chunks, topology disables chunking
+	settings.bComputeBounds = true;
+	settings.bCheckFaceIndices = true;
+	settings.bCountUniqueVerts = true;
+	return settings;
+};
+
+void CorpusChecker::parseFile(const BenchmarkCorpus& corpus, const ProcessingSettings& settings, WorkerPool* chunkWorkerPool, bool bStream,
+	PrimDataStore& store, std::string& log)
+{
+	LogManager loggingManager;
+	loggingManager.enableCapture();
+	loggingManager.setProcessingWarningLimit(processingWarningLimit);
+	{
+		FileProcessor processor(corpus.filepath, settings, loggingManager, chunkWorkerPool);
+		if (bStream)
+		{
+			processor.setCollectionClosedCallback([&store](const PrimDataCollection& collection) { store.append(collection); });
+		}
+		processor.processFile();
+		store.appendRows(processor.resultStore);
+	}
+
+	log.clear();
+	std::istringstream capturedLog(loggingManager.takeCapturedLog());
+	std::string line;
+	while (std::getline(capturedLog, line))
+	{
+		if (line.find(" lines in ") == line.npos)
+		{
+			log += line;
+			log += '\n';
+		}
+	}
+};
+
+std::string CorpusChecker::compareStores(const PrimDataStore& expected, PrimDataStore& actual)
+{
+	if (actual.size() != expected.size())
+	{
+		return std::format("{} rows, expected {}", actual.size(), expected.size());
+	}
+	for (size_t row = 0; row < expected.size(); row++)
+	{
+		for (size_t axis = 0; axis < 3; axis++)
+		{
+			const double expectedSum = expected.positionSums[row][axis];
+			if (std::abs(actual.positionSums[row][axis] - expectedSum) > std::max(1.0, std::abs(expectedSum)) * 1e-9)
+			{
+				return std::format("row {} '{}' position sum differs", row, expected.getName(row));
+			}
+		}
+		actual.positionSums[row] = expected.positionSums[row];
+	}
+
+	auto serialize = [](const PrimDataStore& store)
+		{
+			std::ostringstream stream(std::ios::binary);
+			store.writeTo(stream);
+			return std::move(stream).str();
+		};
+	if (serialize(actual) == serialize(expected))
+	{
+		return {};
+	}
+
+	// same serialization row by row to find the first difference
+	PrimDataCollection expectedRow{ std::string_view() };
+	PrimDataCollection actualRow{ std::string_view() };
+	PrimDataStore expectedRowStore;
+	PrimDataStore actualRowStore;
+	for (size_t row = 0; row < expected.size(); row++)
+	{
+		expected.load(row, expectedRow);
+		actual.load(row, actualRow);
+		expectedRowStore.clear();
+		actualRowStore.clear();
+		expectedRowStore.append(expectedRow);
+		actualRowStore.append(actualRow);
+		if (serialize(actualRowStore) != serialize(expectedRowStore))
+		{
+			return std::format("row {} '{}' differs", row, expected.getName(row));
+		}
+	}
+	return "rows differ";
+};
+
+void CorpusChecker::checkChunkedParse(const BenchmarkCorpus& corpus, std::string_view groupingName, const ProcessingSettings& settings,
+	const PrimDataStore& expectedStore, const std::string& expectedLog)
+{
+	WorkerPool chunkWorkerPool(chunkThreadCount);
+	for (const bool bStream : { false, true })
+	{
+		PrimDataStore store;
+		std::string log;
+		parseFile(corpus, settings, &chunkWorkerPool, bStream, store, log);
+
+		const std::string checkName = std::format("chunked, {} ({})", bStream ? "streamed" : "stored", groupingName);
+		if (log != expectedLog)
+		{
+			addResult(corpus.name, checkName, "log differs");
+		}
+		else
+		{
+			addResult(corpus.name, checkName, compareStores(expectedStore, store));
+		}
+	}
+};
+
+void CorpusChecker::checkParseAllocations(const BenchmarkCorpus& corpus, std::string_view groupingName, const ProcessingSettings& settings)
+{
+	const std::string checkName = std::format("parse allocations ({})", groupingName);
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+	LogManager loggingManager;
+	loggingManager.enableCapture();
+	loggingManager.setProcessingWarningLimit(processingWarningLimit);
+	// per file state is bumped from an arena like in the tool
+	FileArena fileArena;
+	FileProcessor processor(corpus.filepath, settings, loggingManager, nullptr, &fileArena);
+
+	const uint64_t allocationCountBefore = getThreadAllocationCount();
+	processor.processFile();
+	const uint64_t allocationCount = getThreadAllocationCount() - allocationCountBefore;
+
+	const uint64_t allocatingLineCount = processor.getAllocatingLineCount();
+	addResult(corpus.name, checkName,
+		allocatingLineCount != 0 ? std::format("{} lines allocated without growing the results", allocatingLineCount) : std::string(),
+		std::format("ok, {} allocations, {:.4f} per line", allocationCount, double(allocationCount) / std::max<uint64_t>(corpus.lineCount, 1)));
+#else
+	addResult(corpus.name, checkName, {}, "skipped, allocations are only counted in debug builds");
+#endif
+};
+
+void CorpusChecker::checkStoreRoundTrip(const BenchmarkCorpus& corpus, std::string_view groupingName, const PrimDataStore& store)
+{
+	std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+	store.writeTo(stream);
+	PrimDataStore readStore;
+	const std::string checkName = std::format("store round trip ({})", groupingName);
+	if (!readStore.readFrom(stream))
+	{
+		addResult(corpus.name, checkName, "read failed");
+	}
+	else
+	{
+		addResult(corpus.name, checkName, compareStores(store, readStore));
+	}
+};
+
+bool CorpusChecker::run(const std::vector<BenchmarkCorpus>& corpora)
+{
+	static constexpr std::pair<DataCollectionGrouping, std::string_view> groupings[] =
+	{
+		{ DataCollectionGrouping::File,        "file" },
+		{ DataCollectionGrouping::Object,      "object" },
+		{ DataCollectionGrouping::Vertexgroup, "group" },
+	};
+
+	uint32_t chunkedCorpusCount = 0;
+	for (const BenchmarkCorpus& corpus : corpora)
+	{
+		const bool bIsChunked = corpus.byteCount >= FileProcessor::minChunkedFileSize;
+		chunkedCorpusCount += bIsChunked;
+		for (const auto& [grouping, groupingName] : groupings)
+		{
+			const ProcessingSettings settings = makeSettings(grouping);
+			PrimDataStore expectedStore;
+			std::string expectedLog;
+			parseFile(corpus, settings, nullptr, false, expectedStore, expectedLog);
+
+			checkParseAllocations(corpus, groupingName, settings);
+			checkStoreRoundTrip(corpus, groupingName, expectedStore);
+			if (bIsChunked)
+			{
+				checkChunkedParse(corpus, groupingName, settings, expectedStore, expectedLog);
+			}
+		}
+	}
+	if (chunkedCorpusCount == 0)
+	{
+		addResult("", "chunked", "no corpus is large enough to be chunked, raise -scale");
+	}
+	return failureCount == 0;
+};
+
+const std::string& CorpusChecker::getReport() const
+{
+	return report;
+};
+
+// --------------------------------
+// usage: ObjAnalyzerBench [-scale N] [-runs N] [-dir path] [-keep] [-check]
+int main(int argc, char* argv[])
+{
+	uint32_t scale = 1;
+	uint32_t runCount = 5;
+	std::filesystem::path corpusDir = std::filesystem::temp_directory_path() / "objanalyzer_bench";
+	bool bKeepCorpus = false;
+	// verify results instead of timing
+	bool bCheck = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		const std::string_view value = i + 1 < argc ? std::string_view(argv[i + 1]) : std::string_view();
+		if (arg == "-scale" && std::from_chars(value.data(), value.data() + value.size(), scale).ec == std::errc() && scale != 0)
+		{
+			i++;
+		}
+		else if (arg == "-runs" && std::from_chars(value.data(), value.data() + value.size(), runCount).ec == std::errc() && runCount != 0)
+		{
+			i++;
+		}
+		else if (arg == "-dir" && !value.empty())
+		{
+			corpusDir = value;
+			i++;
+		}
+		else if (arg == "-keep")
+		{
+			bKeepCorpus = true;
+		}
+		else if (arg == "-check")
+		{
+			bCheck = true;
+		}
+		else
+		{
+			std::cout << "Usage: ObjAnalyzerBench [-scale N] [-runs N] [-dir path] [-keep] [-check]\n";
+			return 1;
+		}
+	}
+
+	std::cout << std::format("Generating corpora in '{}' (scale {})...\n", corpusDir.generic_string(), scale);
+	const std::vector<BenchmarkCorpus> corpora = BenchmarkCorpusGenerator(corpusDir, scale).generateAll();
+	for (const BenchmarkCorpus& corpus : corpora)
+	{
+		std::cout << std::format("  {:<14} {:>8.1f} MB {:>12} lines\n", corpus.name, double(corpus.byteCount) / (1 << 20), corpus.lineCount);
+	}
+
+	bool bSucceeded = true;
+	if (bCheck)
+	{
+		std::cout << std::format("Running checks, simd: {}\n\n", getSimdLevelName(getSimdLevel()));
+		CorpusChecker checker;
+		bSucceeded = checker.run(corpora);
+		std::cout << checker.getReport();
+	}
+	else
+	{
+		std::cout << std::format("Running benchmarks, best of {} runs, simd: {}\n\n", runCount, getSimdLevelName(getSimdLevel()));
+		BenchmarkRunner runner(runCount);
+		runner.run(corpora, corpusDir);
+		std::cout << runner.formatResults();
+	}
+
+	if (!bKeepCorpus)
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(corpusDir, errorCode);
+	}
+	return bSucceeded ? 0 : 1;
+};
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LogManager.h"
+#include "OutputHandlers.h"
+#include "Processors.h"
+#include "Settings.h"
+#include "WorkerPool.h"
+
+// synthetic obj file modelled after a kind of asset seen in production
+struct BenchmarkCorpus
+{
+	std::string name;
+	std::filesystem::path filepath;
+	uint64_t byteCount = 0;
+	uint64_t lineCount = 0;
+};
+
+// writes the synthetic corpora, scale multiplies the amount of geometry of each
+class BenchmarkCorpusGenerator
+{
+	const std::filesystem::path outputDir;
+	const uint32_t scale;
+
+	BenchmarkCorpus writeCorpus(std::string_view name, const std::function<void(std::string&)>& generate) const;
+
+	// grid of triangulated quads, ex: game ready meshes
+	static void generateDenseTris(std::string& data, uint32_t gridSize);
+	// extruded ngon profiles with mixed face sizes, ex: cad exports
+	static void generateNgonCad(std::string& data, uint32_t profileCount);
+	// point cloud with vertex colors & normals, ex: photogrammetry scans
+	static void generateVertexColorScan(std::string& data, uint32_t pointCount);
+	// many single triangle objects with materials, ex: kitbash libraries
+	static void generateTinyObjects(std::string& data, uint32_t objectCount);
+	// small objects with unnamed objects, invalid vertices & face indices, ex: hand edited or broken exports
+	static void generateMessyExport(std::string& data, uint32_t objectCount);
+
+public:
+	BenchmarkCorpusGenerator(const std::filesystem::path& outputDir, uint32_t scale);
+
+	std::vector<BenchmarkCorpus> generateAll() const;
+};
+
+struct BenchmarkResult
+{
+	std::string name;
+	std::string corpusName;
+	std::chrono::nanoseconds bestTime{};
+	uint64_t byteCount = 0;
+	// lines for parsing benchmarks, collections for output benchmarks
+	uint64_t itemCount = 0;
+	std::string_view itemUnit;
+};
+
+// times each part of the pipeline in isolation, keeping the best of several runs
+class BenchmarkRunner
+{
+	const uint32_t runCount;
+	std::vector<BenchmarkResult> results;
+	// prevents the optimizer from discarding benchmarked work
+	uint64_t sink = 0;
+
+	void addResult(std::string_view name, const BenchmarkCorpus& corpus, uint64_t byteCount, uint64_t itemCount, std::string_view itemUnit, const std::function<void()>& run);
+
+	void runLineProcessorBenchmarks(const BenchmarkCorpus& corpus, std::string_view fileData);
+	void runFileProcessorBenchmarks(const BenchmarkCorpus& corpus);
+	void runOutputterBenchmarks(const BenchmarkCorpus& corpus, const std::filesystem::path& csvDir);
+
+	static ProcessingSettings makeSettings(ProcessingMode mode, DataCollectionGrouping grouping);
+
+public:
+	BenchmarkRunner(uint32_t runCount);
+
+	void run(const std::vector<BenchmarkCorpus>& corpora, const std::filesystem::path& csvDir);
+
+	// table with MB/s & lines/s per benchmark
+	std::string formatResults() const;
+};
+
+// parses the corpora in configurations that must agree & reports any difference, run with ObjAnalyzerBench -check
+// run from a debug build to also check that parsing lines doesn't allocate
+class CorpusChecker
+{
+	std::string report;
+	uint32_t failureCount = 0;
+
+	static constexpr uint32_t chunkThreadCount = 4;
+	// low enough for the warnings of the messy corpus to be tallied past it
+	static constexpr uint32_t processingWarningLimit = 50;
+
+	// note is shown instead of failure if the check passed
+	void addResult(std::string_view corpusName, std::string_view checkName, std::string_view failure, std::string_view note = "ok");
+
+	// chunked parse on a worker pool, stored & streamed, against the single threaded parse of the same file
+	void checkChunkedParse(const BenchmarkCorpus& corpus, std::string_view groupingName, const ProcessingSettings& settings,
+		const PrimDataStore& expectedStore, const std::string& expectedLog);
+	// heap allocations of a single threaded parse, only debug builds count them, see AllocationCounter.h
+	// fails if a line allocated without growing the results
+	void checkParseAllocations(const BenchmarkCorpus& corpus, std::string_view groupingName, const ProcessingSettings& settings);
+	// rows written & read back the way the result cache does
+	void checkStoreRoundTrip(const BenchmarkCorpus& corpus, std::string_view groupingName, const PrimDataStore& store);
+
+	static ProcessingSettings makeSettings(DataCollectionGrouping grouping);
+	// rows of corpus as parsed with settings, log is the captured log without timings
+	static void parseFile(const BenchmarkCorpus& corpus, const ProcessingSettings& settings, WorkerPool* chunkWorkerPool, bool bStream,
+		PrimDataStore& store, std::string& log);
+	// empty if equal, else the first differing row
+	// position sums are added in a different order by chunks, so they only need to match closely & are then copied to actual
+	static std::string compareStores(const PrimDataStore& expected, PrimDataStore& actual);
+
+public:
+	// false if any check failed
+	bool run(const std::vector<BenchmarkCorpus>& corpora);
+
+	// one line per check
+	const std::string& getReport() const;
+};
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "BlockDecompressor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef OBJANALYZER_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef OBJANALYZER_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+CompressionFormat getCompressionFormat(const std::filesystem::path& filepath)
+{
+	const std::filesystem::path extension = filepath.extension();
+	if (extension == ".gz")
+	{
+		return CompressionFormat::Gzip;
+	}
+	if (extension == ".zst")
+	{
+		return CompressionFormat::Zstd;
+	}
+	return CompressionFormat::None;
+}
+
+bool isCompressionSupported(CompressionFormat format)
+{
+	switch (format)
+	{
+#ifdef OBJANALYZER_HAS_ZLIB
+	case CompressionFormat::Gzip: return true;
+#endif
+#ifdef OBJANALYZER_HAS_ZSTD
+	case CompressionFormat::Zstd: return true;
+#endif
+	default: return false;
+	}
+}
+
+std::filesystem::path removeCompressionExtension(const std::filesystem::path& filepath)
+{
+	if (getCompressionFormat(filepath) == CompressionFormat::None)
+	{
+		return filepath;
+	}
+	return std::filesystem::path(filepath).replace_extension();
+}
+
+// --------------------------------
+BlockDecompressor::BlockDecompressor(const std::filesystem::path& filepath, CompressionFormat format)
+	: format(format)
+	, compressedStream(filepath, std::ios::binary)
+{
+	if (compressedStream.is_open() && isCompressionSupported(format))
+	{
+		producerThread = std::thread(&BlockDecompressor::producerLoop, this);
+	}
+};
+
+BlockDecompressor::~BlockDecompressor()
+{
+	{
+		std::lock_guard lock(blockMutex);
+		bIsStopping = true;
+	}
+	blockCondition.notify_all();
+	if (producerThread.joinable())
+	{
+		producerThread.join();
+	}
+};
+
+bool BlockDecompressor::isOpen() const
+{
+	return producerThread.joinable();
+};
+
+bool BlockDecompressor::hasFailed() const
+{
+	std::lock_guard lock(blockMutex);
+	return bHasFailed;
+};
+
+void BlockDecompressor::producerLoop()
+{
+	bool bSucceeded = false;
+	try
+	{
+		switch (format)
+		{
+		case CompressionFormat::Gzip: bSucceeded = decompressGzip(); break;
+		case CompressionFormat::Zstd: bSucceeded = decompressZstd(); break;
+		default: break;
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		bSucceeded = false;
+	}
+
+	{
+		std::lock_guard lock(blockMutex);
+		bIsFinished = true;
+		bHasFailed = !bSucceeded && !bIsStopping;
+	}
+	blockCondition.notify_all();
+};
+
+BlockDecompressor::Block BlockDecompressor::takeFreeBlock()
+{
+	{
+		std::lock_guard lock(blockMutex);
+		if (!freeBlocks.empty())
+		{
+			Block block = std::move(freeBlocks.back());
+			freeBlocks.pop_back();
+			return block;
+		}
+	}
+	return Block{ std::make_unique_for_overwrite<char[]>(blockSize), 0 };
+};
+
+bool BlockDecompressor::pushBlock(Block& block)
+{
+	{
+		std::unique_lock lock(blockMutex);
+		blockCondition.wait(lock, [this]() { return filledBlocks.size() < maxQueuedBlocks || bIsStopping; });
+		if (bIsStopping)
+		{
+			return false;
+		}
+		filledBlocks.push_back(std::move(block));
+	}
+	blockCondition.notify_all();
+	block = takeFreeBlock();
+	return true;
+};
+
+bool BlockDecompressor::decompressGzip()
+{
+#ifdef OBJANALYZER_HAS_ZLIB
+	z_stream stream = {};
+	// +32: accept gzip & zlib headers
+	if (inflateInit2(&stream, 15 + 32) != Z_OK)
+	{
+		return false;
+	}
+
+	std::vector<char> compressedBlock(compressedBlockSize);
+	Block block = takeFreeBlock();
+	bool bInputEnded = false;
+	bool bSucceeded = false;
+	int result = Z_OK;
+	while (true)
+	{
+		if (stream.avail_in == 0 && !bInputEnded)
+		{
+			compressedStream.read(compressedBlock.data(), std::streamsize(compressedBlock.size()));
+			stream.next_in = reinterpret_cast<Bytef*>(compressedBlock.data());
+			stream.avail_in = uInt(compressedStream.gcount());
+			bInputEnded = stream.avail_in == 0;
+			if (compressedStream.bad())
+			{
+				break;
+			}
+		}
+		if (result == Z_STREAM_END)
+		{
+			if (bInputEnded)
+			{
+				bSucceeded = block.size == 0 || pushBlock(block);
+				break;
+			}
+			// another member follows, as written by pigz or by concatenating .gz files
+			inflateReset(&stream);
+		}
+
+		stream.next_out = reinterpret_cast<Bytef*>(block.data.get() + block.size);
+		stream.avail_out = uInt(blockSize - block.size);
+		result = inflate(&stream, Z_NO_FLUSH);
+		block.size = blockSize - stream.avail_out;
+		// Z_BUF_ERROR: no progress possible, the input ended mid member
+		if (result != Z_OK && result != Z_STREAM_END)
+		{
+			break;
+		}
+		if (block.size == blockSize && !pushBlock(block))
+		{
+			break;
+		}
+	}
+	inflateEnd(&stream);
+	return bSucceeded;
+#else
+	return false;
+#endif
+};
+
+bool BlockDecompressor::decompressZstd()
+{
+#ifdef OBJANALYZER_HAS_ZSTD
+	ZSTD_DCtx* context = ZSTD_createDCtx();
+	if (context == nullptr)
+	{
+		return false;
+	}
+
+	std::vector<char> compressedBlock(compressedBlockSize);
+	ZSTD_inBuffer input = { compressedBlock.data(), 0, 0 };
+	Block block = takeFreeBlock();
+	bool bInputEnded = false;
+	bool bSucceeded = false;
+	// 0 once a frame is complete & flushed
+	size_t result = 1;
+	while (true)
+	{
+		if (input.pos == input.size && !bInputEnded)
+		{
+			compressedStream.read(compressedBlock.data(), std::streamsize(compressedBlock.size()));
+			input.size = size_t(compressedStream.gcount());
+			input.pos = 0;
+			bInputEnded = input.size == 0;
+			if (compressedStream.bad())
+			{
+				break;
+			}
+		}
+		// more frames may follow a complete one, as written by concatenating .zst files
+		if (result == 0 && bInputEnded)
+		{
+			bSucceeded = block.size == 0 || pushBlock(block);
+			break;
+		}
+
+		ZSTD_outBuffer output = { block.data.get() + block.size, blockSize - block.size, 0 };
+		result = ZSTD_decompressStream(context, &output, &input);
+		if (ZSTD_isError(result))
+		{
+			break;
+		}
+		block.size += output.pos;
+		// no progress possible, the input ended mid frame
+		if (bInputEnded && output.pos == 0 && result != 0)
+		{
+			break;
+		}
+		if (block.size == blockSize && !pushBlock(block))
+		{
+			break;
+		}
+	}
+	ZSTD_freeDCtx(context);
+	return bSucceeded;
+#else
+	return false;
+#endif
+};
+
+size_t BlockDecompressor::read(char* dest, size_t size)
+{
+	size_t readSize = 0;
+	while (readSize < size)
+	{
+		if (readOffset == readBlock.size)
+		{
+			{
+				std::unique_lock lock(blockMutex);
+				if (readBlock.data != nullptr)
+				{
+					readBlock.size = 0;
+					freeBlocks.push_back(std::move(readBlock));
+				}
+				blockCondition.wait(lock, [this]() { return !filledBlocks.empty() || bIsFinished; });
+				if (filledBlocks.empty())
+				{
+					readBlock = Block();
+					readOffset = 0;
+					break;
+				}
+				readBlock = std::move(filledBlocks.front());
+				filledBlocks.pop_front();
+				readOffset = 0;
+			}
+			// producer may be waiting for queue space
+			blockCondition.notify_all();
+		}
+
+		const size_t copySize = std::min(size - readSize, readBlock.size - readOffset);
+		std::memcpy(dest + readSize, readBlock.data.get() + readOffset, copySize);
+		readSize += copySize;
+		readOffset += copySize;
+	}
+	return readSize;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// formats are only available when the build found their library, see CMakeLists.txt
+enum class CompressionFormat : uint8_t
+{
+	None,
+	Gzip, // .gz, needs OBJANALYZER_HAS_ZLIB
+	Zstd, // .zst, needs OBJANALYZER_HAS_ZSTD
+};
+
+// from the last extension, None for any other file
+CompressionFormat getCompressionFormat(const std::filesystem::path& filepath);
+bool isCompressionSupported(CompressionFormat format);
+// "a.obj.gz" -> "a.obj", other paths are returned as is
+std::filesystem::path removeCompressionExtension(const std::filesystem::path& filepath);
+
+// decompresses a file on its own thread into fixed size blocks,
+// so the next blocks are decompressed while the reader parses the current one, no temp file is written
+class BlockDecompressor
+{
+	const CompressionFormat format;
+	std::ifstream compressedStream;
+
+	static constexpr size_t blockSize = 1 << 20; // 1 MiB
+	static constexpr size_t compressedBlockSize = 256 << 10; // 256 KiB
+	// decompressed blocks the producer may run ahead of the reader
+	static constexpr size_t maxQueuedBlocks = 4;
+
+	// not a vector, so blocks are not zeroed before being decompressed into
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		size_t size = 0;
+	};
+	// decompressed blocks in file order, guarded by blockMutex
+	std::deque<Block> filledBlocks;
+	// blocks handed back by the reader for reuse
+	std::vector<Block> freeBlocks;
+	mutable std::mutex blockMutex;
+	std::condition_variable blockCondition;
+	// set by the producer once all data is queued, or it failed
+	bool bIsFinished = false;
+	bool bHasFailed = false;
+	// set by the reader to stop the producer early
+	bool bIsStopping = false;
+
+	// block being read & read offset into it, only touched by the reader
+	Block readBlock;
+	size_t readOffset = 0;
+
+	std::thread producerThread;
+
+	void producerLoop();
+	// decompress compressedStream into blocks, false on corrupt or truncated data
+	bool decompressGzip();
+	bool decompressZstd();
+	// empty block of blockSize, recycled if possible
+	Block takeFreeBlock();
+	// queue block for the reader & replace it with an empty one, waits while maxQueuedBlocks are queued
+	// returns false if the reader stopped, in which case the producer should return
+	bool pushBlock(Block& block);
+
+public:
+	// starts decompressing right away, isOpen() is false if the file can't be opened or format is not supported
+	BlockDecompressor(const std::filesystem::path& filepath, CompressionFormat format);
+	// stops the producer without waiting for the rest of the file
+	~BlockDecompressor();
+
+	BlockDecompressor(const BlockDecompressor&) = delete;
+	BlockDecompressor& operator=(const BlockDecompressor&) = delete;
+
+	bool isOpen() const;
+	// true once the producer hit corrupt or truncated data, only final after read() returned less than requested
+	bool hasFailed() const;
+
+	// copies the next decompressed bytes to dest, waiting for the producer if needed
+	// returns less than size only at the end of the data
+	size_t read(char* dest, size_t size);
+};
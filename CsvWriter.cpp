@@ -0,0 +1,72 @@
+#include "CsvWriter.h"
+
+CsvFileWriter::CsvFileWriter(const std::filesystem::path& filepath, const char separator)
+	: separator(separator)
+{
+	{
+		std::ifstream existingFile(filepath, std::ios::binary);
+		bHasExistingHeader = existingFile && std::getline(existingFile, existingHeader);
+		if (existingHeader.ends_with('\r'))
+		{
+			existingHeader.pop_back();
+		}
+	}
+
+	fileStream.open(filepath, std::ios::binary | std::ios::app);
+	bHasFailed = !fileStream.is_open();
+	buffer.reserve(flushThreshold + 4096);
+};
+
+CsvFileWriter::~CsvFileWriter()
+{
+	// errors can't be reported here, call flush() before to check them
+	flush();
+};
+
+bool CsvFileWriter::isOpen() const
+{
+	return fileStream.is_open();
+};
+
+bool CsvFileWriter::hasFailed() const
+{
+	return bHasFailed;
+};
+
+bool CsvFileWriter::hasHeaderMismatch() const
+{
+	return bHeaderMismatch;
+};
+
+void CsvFileWriter::endRow()
+{
+	if (bIsHeaderRow && bHasExistingHeader)
+	{
+		// columns changed between versions & depend on the mode, rows appended under another header would be misaligned
+		bHeaderMismatch = buffer != existingHeader;
+		buffer.clear();
+		bIsRowEmpty = true;
+		bIsHeaderRow = false;
+		return;
+	}
+	buffer += '\n';
+	bIsRowEmpty = true;
+	bIsHeaderRow = false;
+
+	if (buffer.size() >= flushThreshold)
+	{
+		flush();
+	}
+};
+
+bool CsvFileWriter::flush()
+{
+	if (!buffer.empty() && fileStream.is_open())
+	{
+		fileStream.write(buffer.data(), std::streamsize(buffer.size()));
+		fileStream.flush();
+		bHasFailed |= !fileStream;
+	}
+	buffer.clear();
+	return !bHasFailed;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// csv file kept open for the whole run, rows are formatted into a buffer & written in large blocks
+// ex: writer.addField(name); writer.addField(vertCount); writer.endRow();
+class CsvFileWriter
+{
+	static constexpr size_t flushThreshold = 1 << 20; // 1 MiB
+
+	std::ofstream fileStream;
+	std::string buffer;
+	const char separator;
+	bool bIsRowEmpty = true;
+	bool bHasFailed = false;
+	// first line of the file being appended to, the header row is compared against it instead of being written
+	std::string existingHeader;
+	bool bIsHeaderRow = true;
+	bool bHasExistingHeader = false;
+	bool bHeaderMismatch = false;
+
+	inline void addSeparator()
+	{
+		if (!bIsRowEmpty)
+		{
+			buffer += separator;
+		}
+		bIsRowEmpty = false;
+	}
+
+public:
+	// appends to existing files
+	// the first row must be the header, it is written to new or empty files & compared with the header of existing ones
+	CsvFileWriter(const std::filesystem::path& filepath, const char separator = ',');
+	~CsvFileWriter();
+
+	CsvFileWriter(const CsvFileWriter&) = delete;
+	CsvFileWriter& operator=(const CsvFileWriter&) = delete;
+
+	bool isOpen() const;
+	bool hasFailed() const;
+	// true once the header row is ended & differs from the header of the file being appended to
+	bool hasHeaderMismatch() const;
+
+	inline void addField(std::string_view value)
+	{
+		addSeparator();
+		buffer += value;
+	}
+
+	// bools are written as 0/1
+	template<typename T> requires std::is_integral_v<T>
+	inline void addField(T value)
+	{
+		addSeparator();
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			buffer += value ? '1' : '0';
+		}
+		else
+		{
+			char digits[24];
+			buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+		}
+	}
+
+	inline void addField(double value)
+	{
+		addSeparator();
+		std::format_to(std::back_inserter(buffer), "{:f}", value);
+	}
+
+	// empty field, ex: for skipped checks
+	inline void addEmptyField()
+	{
+		addSeparator();
+	}
+
+	void endRow();
+	// returns false if any write failed
+	bool flush();
+};
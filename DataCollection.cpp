@@ -1,17 +1,153 @@
 #include "DataCollection.h"
 
+#include "MaterialLibrary.h"
+
 PrimDataCollection::PrimDataCollection(std::string_view objName) : name(objName) {};
 
+void PrimDataCollection::reset(std::string_view objName)
+{
+	std::string keptName = std::move(name);
+	std::vector<uint32_t> keptMaterialIds = std::move(materialIds);
+	std::vector<uint32_t> keptTextureIds = std::move(textureIds);
+	std::vector<uint32_t> keptUndefinedMaterialIds = std::move(undefinedMaterialIds);
+
+	*this = PrimDataCollection(std::string_view());
+
+	name = std::move(keptName);
+	name.assign(objName);
+	materialIds = std::move(keptMaterialIds);
+	materialIds.clear();
+	textureIds = std::move(keptTextureIds);
+	textureIds.clear();
+	undefinedMaterialIds = std::move(keptUndefinedMaterialIds);
+	undefinedMaterialIds.clear();
+};
+
+// add the values of from missing in into, both sorted & unique
+template<typename T>
+static void mergeSorted(std::vector<T>& into, const std::vector<T>& from)
+{
+	if (from.empty())
+	{
+		return;
+	}
+	std::vector<T> merged;
+	merged.reserve(into.size() + from.size());
+	std::set_union(into.begin(), into.end(), from.begin(), from.end(), std::back_inserter(merged));
+	into = std::move(merged);
+}
+
 size_t PrimDataCollection::getMaterialCount() const
 {
-	return hashedMaterialSet.size();
+	return materialIds.size();
 }
 
 bool PrimDataCollection::addMaterial(std::string_view& materialName)
 {
-	size_t hashedMaterialName = std::hash<std::string_view>{}(materialName);
-	// .second represents wether inserted entry was new (didn't previously exist)
-	return hashedMaterialSet.insert(hashedMaterialName).second;
+	const uint32_t materialId = getMaterialNameTable().intern(materialName);
+	auto it = std::lower_bound(materialIds.begin(), materialIds.end(), materialId);
+	if (it != materialIds.end() && *it == materialId)
+	{
+		return false;
+	}
+	materialIds.insert(it, materialId);
+	return true;
+};
+
+const std::vector<uint32_t>& PrimDataCollection::getMaterialIds() const
+{
+	return materialIds;
+};
+
+void PrimDataCollection::resolveMaterials(const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries)
+{
+	textureIds.clear();
+	undefinedMaterialIds.clear();
+	resolveMaterialIds(materialIds, libraries, textureIds, undefinedMaterialIds);
+};
+
+void PrimDataCollection::resolveMaterialIds(std::span<const uint32_t> materialIds, const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries,
+	std::vector<uint32_t>& textureIds, std::vector<uint32_t>& undefinedMaterialIds)
+{
+	const MaterialNameTable& materialNameTable = getMaterialNameTable();
+	const size_t textureStart = textureIds.size();
+	for (const uint32_t materialId : materialIds)
+	{
+		const std::string_view materialName = materialNameTable.getName(materialId);
+		const std::vector<uint32_t>* textures = nullptr;
+		for (const std::shared_ptr<const MaterialLibrary>& library : libraries)
+		{
+			textures = library->findTextures(materialName);
+			if (textures)
+			{
+				break;
+			}
+		}
+
+		if (textures)
+		{
+			textureIds.insert(textureIds.end(), textures->begin(), textures->end());
+		}
+		else
+		{
+			// materialIds is sorted, so this stays sorted
+			undefinedMaterialIds.push_back(materialId);
+		}
+	}
+	std::sort(textureIds.begin() + textureStart, textureIds.end());
+	textureIds.erase(std::unique(textureIds.begin() + textureStart, textureIds.end()), textureIds.end());
+};
+
+size_t PrimDataCollection::getTextureCount() const
+{
+	return textureIds.size();
+};
+
+size_t PrimDataCollection::getUndefinedMaterialCount() const
+{
+	return undefinedMaterialIds.size();
+};
+
+std::vector<std::string_view> PrimDataCollection::getUndefinedMaterialNames() const
+{
+	const MaterialNameTable& materialNameTable = getMaterialNameTable();
+	std::vector<std::string_view> undefinedMaterialNames;
+	undefinedMaterialNames.reserve(undefinedMaterialIds.size());
+	for (const uint32_t materialId : undefinedMaterialIds)
+	{
+		undefinedMaterialNames.push_back(materialNameTable.getName(materialId));
+	}
+	std::sort(undefinedMaterialNames.begin(), undefinedMaterialNames.end());
+	return undefinedMaterialNames;
+};
+
+bool PrimDataCollection::hasBounds() const
+{
+	return boundedVertCount != 0;
+};
+
+std::array<float, 3> PrimDataCollection::getExtent() const
+{
+	if (!hasBounds())
+	{
+		return {};
+	}
+	return { boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] };
+};
+
+float PrimDataCollection::getMaxExtent() const
+{
+	const std::array<float, 3> extent = getExtent();
+	return std::max({ extent[0], extent[1], extent[2] });
+};
+
+std::array<double, 3> PrimDataCollection::getCentroid() const
+{
+	if (!hasBounds())
+	{
+		return {};
+	}
+	return { positionSum[0] / boundedVertCount, positionSum[1] / boundedVertCount, positionSum[2] / boundedVertCount };
 };
 
 bool PrimDataCollection::isEmpty() const
@@ -24,21 +160,396 @@ bool PrimDataCollection::isEmpty() const
 		);
 };
 
+void PrimDataCollection::merge(const PrimDataCollection& other)
+{
+	vertCount      += other.vertCount;
+	pointCount     += other.pointCount;
+	lineCount      += other.lineCount;
+	faceTotalCount += other.faceTotalCount;
+	faceTriCount   += other.faceTriCount;
+	faceQuadCount  += other.faceQuadCount;
+	faceNgonCount  += other.faceNgonCount;
+	faceTriEquivalentCount += other.faceTriEquivalentCount;
+	subgroupCount  += other.subgroupCount;
+	invalidFaceIndexCount += other.invalidFaceIndexCount;
+	degenerateFaceCount   += other.degenerateFaceCount;
+	boundaryEdgeCount     += other.boundaryEdgeCount;
+	nonManifoldEdgeCount  += other.nonManifoldEdgeCount;
+	isolatedVertCount     += other.isolatedVertCount;
+
+	hasVertColor   |= other.hasVertColor;
+	hasVertNormals |= other.hasVertNormals;
+	hasUvs         |= other.hasUvs;
+	// unique counts can't be summed, FileProcessor::mergeChunk sets them from the merged positions
+
+	for (size_t axis = 0; axis < 3; axis++)
+	{
+		boundsMin[axis]   = std::min(boundsMin[axis], other.boundsMin[axis]);
+		boundsMax[axis]   = std::max(boundsMax[axis], other.boundsMax[axis]);
+		positionSum[axis] += other.positionSum[axis];
+	}
+	boundedVertCount += other.boundedVertCount;
+
+	mergeSorted(materialIds, other.materialIds);
+	mergeSorted(textureIds, other.textureIds);
+	mergeSorted(undefinedMaterialIds, other.undefinedMaterialIds);
+};
+
+template<typename T>
+static void writePod(std::ostream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void readPod(std::istream& stream, T& value)
+{
+	stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void writeColumn(std::ostream& stream, const std::pmr::vector<T>& column)
+{
+	stream.write(reinterpret_cast<const char*>(column.data()), std::streamsize(column.size() * sizeof(T)));
+}
+
+template<typename T>
+static bool readColumn(std::istream& stream, std::pmr::vector<T>& column, uint64_t size)
+{
+	// grow in steps so a corrupt size fails at the end of the stream instead of allocating it up front
+	constexpr uint64_t stepSize = 1 << 20;
+	column.clear();
+	while (column.size() < size && stream)
+	{
+		const size_t readStart = column.size();
+		column.resize(readStart + size_t(std::min(stepSize, size - readStart)));
+		stream.read(reinterpret_cast<char*>(column.data() + readStart), std::streamsize((column.size() - readStart) * sizeof(T)));
+	}
+	return bool(stream);
+}
+
+template<typename T>
+static void writeRaggedColumn(std::ostream& stream, const RaggedColumn<T>& column)
+{
+	writePod(stream, uint64_t(column.values.size()));
+	writeColumn(stream, column.values);
+	writeColumn(stream, column.rowEnds);
+}
+
+template<typename T>
+static bool readRaggedColumn(std::istream& stream, RaggedColumn<T>& column, uint64_t rowCount)
+{
+	uint64_t valueCount = 0;
+	readPod(stream, valueCount);
+	if (!readColumn(stream, column.values, valueCount) || !readColumn(stream, column.rowEnds, rowCount))
+	{
+		return false;
+	}
+	// rows must stay within values
+	uint64_t previousRowEnd = 0;
+	for (const uint64_t rowEnd : column.rowEnds)
+	{
+		if (rowEnd < previousRowEnd || rowEnd > valueCount)
+		{
+			return false;
+		}
+		previousRowEnd = rowEnd;
+	}
+	return previousRowEnd == valueCount;
+}
+
+// ids only exist for the run, so they are stored as indices into the strings of the ids the columns use
+static void writeInternedColumns(std::ostream& stream, const MaterialNameTable& table, std::initializer_list<const RaggedColumn<uint32_t>*> columns)
+{
+	std::vector<uint32_t> usedIds;
+	for (const RaggedColumn<uint32_t>* column : columns)
+	{
+		usedIds.insert(usedIds.end(), column->values.begin(), column->values.end());
+	}
+	std::sort(usedIds.begin(), usedIds.end());
+	usedIds.erase(std::unique(usedIds.begin(), usedIds.end()), usedIds.end());
+
+	writePod(stream, uint64_t(usedIds.size()));
+	for (const uint32_t id : usedIds)
+	{
+		const std::string_view text = table.getName(id);
+		writePod(stream, uint32_t(text.size()));
+		stream.write(text.data(), std::streamsize(text.size()));
+	}
+
+	for (const RaggedColumn<uint32_t>* column : columns)
+	{
+		RaggedColumn<uint32_t> indices;
+		indices.rowEnds = column->rowEnds;
+		indices.values.reserve(column->values.size());
+		for (const uint32_t id : column->values)
+		{
+			indices.values.push_back(uint32_t(std::lower_bound(usedIds.begin(), usedIds.end(), id) - usedIds.begin()));
+		}
+		writeRaggedColumn(stream, indices);
+	}
+}
+
+static bool readInternedColumns(std::istream& stream, MaterialNameTable& table, std::initializer_list<RaggedColumn<uint32_t>*> columns, uint64_t rowCount)
+{
+	// guard against corrupt data requesting huge allocations
+	constexpr uint32_t maxTextSize = 1 << 20;
+
+	uint64_t usedIdCount = 0;
+	readPod(stream, usedIdCount);
+	std::vector<uint32_t> usedIds;
+	std::string text;
+	for (uint64_t i = 0; i < usedIdCount && stream; i++)
+	{
+		uint32_t textSize = 0;
+		readPod(stream, textSize);
+		if (!stream || textSize > maxTextSize)
+		{
+			return false;
+		}
+		text.resize(textSize);
+		stream.read(text.data(), std::streamsize(textSize));
+		usedIds.push_back(table.intern(text));
+	}
+
+	for (RaggedColumn<uint32_t>* column : columns)
+	{
+		if (!readRaggedColumn(stream, *column, rowCount))
+		{
+			return false;
+		}
+		for (uint32_t& id : column->values)
+		{
+			if (id >= usedIds.size())
+			{
+				return false;
+			}
+			id = usedIds[id];
+		}
+		// ids of this run are in a different order than when stored
+		uint64_t rowStart = 0;
+		for (const uint64_t rowEnd : column->rowEnds)
+		{
+			std::sort(column->values.begin() + rowStart, column->values.begin() + rowEnd);
+			rowStart = rowEnd;
+		}
+	}
+	return bool(stream);
+}
+
+static uint8_t packFlags(const PrimDataCollection& collection)
+{
+	return uint8_t(collection.hasVertColor | collection.hasVertNormals << 1 | collection.hasUvs << 2 | collection.uniqueVertCountIsUpperBound << 3);
+}
+
+template<typename Func>
+void PrimDataStore::forEachColumn(Func&& func)
+{
+	func(&PrimDataStore::vertCounts,              &PrimDataCollection::vertCount);
+	func(&PrimDataStore::uniqueVertCounts,        &PrimDataCollection::uniqueVertCount);
+	func(&PrimDataStore::pointCounts,             &PrimDataCollection::pointCount);
+	func(&PrimDataStore::lineCounts,              &PrimDataCollection::lineCount);
+	func(&PrimDataStore::faceTotalCounts,         &PrimDataCollection::faceTotalCount);
+	func(&PrimDataStore::faceTriCounts,           &PrimDataCollection::faceTriCount);
+	func(&PrimDataStore::faceQuadCounts,          &PrimDataCollection::faceQuadCount);
+	func(&PrimDataStore::faceNgonCounts,          &PrimDataCollection::faceNgonCount);
+	func(&PrimDataStore::faceTriEquivalentCounts, &PrimDataCollection::faceTriEquivalentCount);
+	func(&PrimDataStore::subgroupCounts,          &PrimDataCollection::subgroupCount);
+	func(&PrimDataStore::invalidFaceIndexCounts,  &PrimDataCollection::invalidFaceIndexCount);
+	func(&PrimDataStore::degenerateFaceCounts,    &PrimDataCollection::degenerateFaceCount);
+	func(&PrimDataStore::boundaryEdgeCounts,      &PrimDataCollection::boundaryEdgeCount);
+	func(&PrimDataStore::nonManifoldEdgeCounts,   &PrimDataCollection::nonManifoldEdgeCount);
+	func(&PrimDataStore::isolatedVertCounts,      &PrimDataCollection::isolatedVertCount);
+	func(&PrimDataStore::boundsMins,              &PrimDataCollection::boundsMin);
+	func(&PrimDataStore::boundsMaxs,              &PrimDataCollection::boundsMax);
+	func(&PrimDataStore::positionSums,            &PrimDataCollection::positionSum);
+	func(&PrimDataStore::boundedVertCounts,       &PrimDataCollection::boundedVertCount);
+	func(&PrimDataStore::flags,                   nullptr);
+}
+
+PrimDataStore::PrimDataStore(std::pmr::memory_resource* resource)
+	: names(resource)
+	, materialIds(resource)
+	, textureIds(resource)
+	, undefinedMaterialIds(resource)
+	, flags(resource)
+	, vertCounts(resource)
+	, uniqueVertCounts(resource)
+	, pointCounts(resource)
+	, lineCounts(resource)
+	, faceTotalCounts(resource)
+	, faceTriCounts(resource)
+	, faceQuadCounts(resource)
+	, faceNgonCounts(resource)
+	, faceTriEquivalentCounts(resource)
+	, subgroupCounts(resource)
+	, invalidFaceIndexCounts(resource)
+	, degenerateFaceCounts(resource)
+	, boundaryEdgeCounts(resource)
+	, nonManifoldEdgeCounts(resource)
+	, isolatedVertCounts(resource)
+	, boundsMins(resource)
+	, boundsMaxs(resource)
+	, positionSums(resource)
+	, boundedVertCounts(resource)
+{
+};
+
+size_t PrimDataStore::size() const
+{
+	return flags.size();
+};
+
+bool PrimDataStore::empty() const
+{
+	return flags.empty();
+};
+
+void PrimDataStore::clear()
+{
+	forEachColumn([this](auto column, auto) { (this->*column).clear(); });
+	names.clear();
+	materialIds.clear();
+	textureIds.clear();
+	undefinedMaterialIds.clear();
+};
+
+void PrimDataStore::append(const PrimDataCollection& collection)
+{
+	forEachColumn([this, &collection](auto column, auto member)
+		{
+			if constexpr (std::is_same_v<decltype(member), std::nullptr_t>)
+			{
+				(this->*column).push_back(packFlags(collection));
+			}
+			else
+			{
+				(this->*column).push_back(collection.*member);
+			}
+		});
+	names.appendRow(collection.name);
+	materialIds.appendRow(collection.materialIds);
+	textureIds.appendRow(collection.textureIds);
+	undefinedMaterialIds.appendRow(collection.undefinedMaterialIds);
+};
+
+void PrimDataStore::appendRows(const PrimDataStore& other, size_t firstRow)
+{
+	forEachColumn([this, &other, firstRow](auto column, auto)
+		{
+			(this->*column).insert((this->*column).end(), (other.*column).begin() + firstRow, (other.*column).end());
+		});
+	names.appendRows(other.names, firstRow);
+	materialIds.appendRows(other.materialIds, firstRow);
+	textureIds.appendRows(other.textureIds, firstRow);
+	undefinedMaterialIds.appendRows(other.undefinedMaterialIds, firstRow);
+};
+
+void PrimDataStore::load(size_t row, PrimDataCollection& collection) const
+{
+	forEachColumn([this, &collection, row](auto column, auto member)
+		{
+			if constexpr (!std::is_same_v<decltype(member), std::nullptr_t>)
+			{
+				collection.*member = (this->*column)[row];
+			}
+		});
+	const uint8_t rowFlags = flags[row];
+	collection.hasVertColor   = rowFlags & 1;
+	collection.hasVertNormals = (rowFlags >> 1) & 1;
+	collection.hasUvs         = (rowFlags >> 2) & 1;
+	collection.uniqueVertCountIsUpperBound = (rowFlags >> 3) & 1;
+
+	collection.name.assign(getName(row));
+	const std::span<const uint32_t> rowMaterialIds = materialIds.getRow(row);
+	collection.materialIds.assign(rowMaterialIds.begin(), rowMaterialIds.end());
+	const std::span<const uint32_t> rowTextureIds = textureIds.getRow(row);
+	collection.textureIds.assign(rowTextureIds.begin(), rowTextureIds.end());
+	const std::span<const uint32_t> rowUndefinedMaterialIds = undefinedMaterialIds.getRow(row);
+	collection.undefinedMaterialIds.assign(rowUndefinedMaterialIds.begin(), rowUndefinedMaterialIds.end());
+};
+
+std::string_view PrimDataStore::getName(size_t row) const
+{
+	const std::span<const char> name = names.getRow(row);
+	return std::string_view(name.data(), name.size());
+};
+
+std::span<const uint32_t> PrimDataStore::getMaterialIds(size_t row) const
+{
+	return materialIds.getRow(row);
+};
+
+void PrimDataStore::resolveMaterials(const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries)
+{
+	std::pmr::memory_resource* resource = flags.get_allocator().resource();
+	RaggedColumn<uint32_t> resolvedTextureIds(resource);
+	RaggedColumn<uint32_t> resolvedUndefinedMaterialIds(resource);
+	// per row, reused
+	std::vector<uint32_t> rowTextureIds;
+	std::vector<uint32_t> rowUndefinedMaterialIds;
+	for (size_t row = 0; row < size(); row++)
+	{
+		rowTextureIds.clear();
+		rowUndefinedMaterialIds.clear();
+		PrimDataCollection::resolveMaterialIds(materialIds.getRow(row), libraries, rowTextureIds, rowUndefinedMaterialIds);
+		resolvedTextureIds.appendRow(rowTextureIds);
+		resolvedUndefinedMaterialIds.appendRow(rowUndefinedMaterialIds);
+	}
+	textureIds = std::move(resolvedTextureIds);
+	undefinedMaterialIds = std::move(resolvedUndefinedMaterialIds);
+};
+
+void PrimDataStore::writeTo(std::ostream& stream) const
+{
+	writePod(stream, uint64_t(size()));
+	forEachColumn([this, &stream](auto column, auto) { writeColumn(stream, this->*column); });
+	writeRaggedColumn(stream, names);
+	writeInternedColumns(stream, getMaterialNameTable(), { &materialIds, &undefinedMaterialIds });
+	writeInternedColumns(stream, getTexturePathTable(), { &textureIds });
+};
+
+bool PrimDataStore::readFrom(std::istream& stream)
+{
+	clear();
+	uint64_t rowCount = 0;
+	readPod(stream, rowCount);
+	bool bIsValid = bool(stream);
+	forEachColumn([this, &stream, &bIsValid, rowCount](auto column, auto)
+		{
+			bIsValid = bIsValid && readColumn(stream, this->*column, rowCount);
+		});
+	return bIsValid
+		&& readRaggedColumn(stream, names, rowCount)
+		&& readInternedColumns(stream, getMaterialNameTable(), { &materialIds, &undefinedMaterialIds }, rowCount)
+		&& readInternedColumns(stream, getTexturePathTable(), { &textureIds }, rowCount);
+};
+
 void PrimDataCollection::debugPrint() const
 {
 	std::cout
 		<< "object name:" << name << std::endl
 		<< "vertex count:" << vertCount << std::endl
+		<< "unique vertex count:" << uniqueVertCount << std::endl
 		<< "point count:" << pointCount << std::endl
 		<< "line count:" << lineCount << std::endl
 		<< "total face count:" << faceTotalCount << std::endl
 		<< "tri count:" << faceTriCount << std::endl
 		<< "quad count:" << faceQuadCount << std::endl
 		<< "Ngon count:" << faceNgonCount << std::endl
+		<< "tri equivalent count:" << faceTriEquivalentCount << std::endl
 		<< "group count:" << subgroupCount << std::endl
+		<< "invalid face index count:" << invalidFaceIndexCount << std::endl
+		<< "degenerate face count:" << degenerateFaceCount << std::endl
+		<< "boundary edge count:" << boundaryEdgeCount << std::endl
+		<< "non manifold edge count:" << nonManifoldEdgeCount << std::endl
+		<< "isolated vertex count:" << isolatedVertCount << std::endl
 		<< "material count:" << getMaterialCount() << std::endl
+		<< "texture count:" << getTextureCount() << std::endl
+		<< "undefined material count:" << getUndefinedMaterialCount() << std::endl
 		<< "has vert color:" << std::boolalpha << bool(hasVertColor) << std::endl
 		<< "has vert normals:" << std::boolalpha << bool(hasVertNormals) << std::endl
 		<< "has uvs:" << std::boolalpha << bool(hasUvs) << std::endl
+		<< "max extent:" << getMaxExtent() << std::endl
 		<< std::endl;
 };
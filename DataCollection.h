@@ -1,19 +1,42 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
 #include <string>
-#include <unordered_set>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "MaterialNameTable.h"
+
+class MaterialLibrary;
 
 // collection of primitive info
+// only the collection being parsed lives as a PrimDataCollection, closed ones are appended to a PrimDataStore
 class PrimDataCollection
 {
-	std::unordered_set<size_t> hashedMaterialSet;
+	friend class PrimDataStore;
+
+	// sorted ids of the run wide MaterialNameTable, collections rarely use more than a few materials
+	std::vector<uint32_t> materialIds;
+	// ids of the run wide texture path table, filled by resolveMaterials(),
+	// kept sorted & unique so merged collections don't count shared ones twice
+	std::vector<uint32_t> textureIds;
+	std::vector<uint32_t> undefinedMaterialIds;
 public:
 	PrimDataCollection(std::string_view objName);
 
+	// start over as an empty collection, keeps the buffers of name & materials for the next collection
+	void reset(std::string_view objName);
+
 	std::string name;
 
 	uint32_t vertCount = 0;
+	// distinct positions, only counted with ProcessingSettings::bCountUniqueVerts
+	uint32_t uniqueVertCount = 0;
 	uint32_t pointCount = 0; // lone vert or point cloud
 	uint32_t lineCount = 0; // lone edge or poly curve
 
@@ -21,20 +44,180 @@ public:
 	uint32_t faceTriCount = 0;
 	uint32_t faceQuadCount = 0;
 	uint32_t faceNgonCount = 0;
+	// triangles after triangulation, n-2 per face of n vertices
+	uint32_t faceTriEquivalentCount = 0;
 	uint16_t subgroupCount = 0;
+	// face v/vt/vn references outside the elements defined so far, only counted with ProcessingSettings::bCheckFaceIndices
+	uint32_t invalidFaceIndexCount = 0;
+	// mesh health, only computed with ProcessingSettings::bAnalyzeTopology
+	uint32_t degenerateFaceCount = 0; // repeated vertex or less than 3 vertices
+	uint32_t boundaryEdgeCount = 0; // used by 1 face
+	uint32_t nonManifoldEdgeCount = 0; // used by more than 2 faces
+	uint32_t isolatedVertCount = 0; // not used by any face
 	// bitfield
 	uint8_t hasVertColor : 1 = 0;
 	uint8_t hasVertNormals : 1 = 0;
 	uint8_t hasUvs : 1 = 0;
-	//leftover bits: 5
+	// set once the unique vertex table hit its memory cap
+	uint8_t uniqueVertCountIsUpperBound : 1 = 0;
+	//leftover bits: 4
+
+	// axis aligned bounds & sum of vertex positions, only computed with ProcessingSettings::bComputeBounds
+	std::array<float, 3> boundsMin = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+	std::array<float, 3> boundsMax = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+	std::array<double, 3> positionSum = {};
+	uint32_t boundedVertCount = 0;
+
+	inline void addVertexPosition(const std::array<float, 3>& position)
+	{
+		for (size_t axis = 0; axis < 3; axis++)
+		{
+			boundsMin[axis] = std::min(boundsMin[axis], position[axis]);
+			boundsMax[axis] = std::max(boundsMax[axis], position[axis]);
+			positionSum[axis] += position[axis];
+		}
+		boundedVertCount++;
+	}
+	// false if no vertex position was added
+	bool hasBounds() const;
+	// size of bounds per axis, 0 if no bounds
+	std::array<float, 3> getExtent() const;
+	// largest axis of getExtent()
+	float getMaxExtent() const;
+	// average vertex position, 0 if no bounds
+	std::array<double, 3> getCentroid() const;
 
 	// returns number of unique materials in this collection
 	size_t getMaterialCount() const;
 	// returns true if material is new
 	bool addMaterial(std::string_view& materialName);
+	// sorted MaterialNameTable ids
+	const std::vector<uint32_t>& getMaterialIds() const;
+
+	// look up the materials used so far in libraries, only done with ProcessingSettings::bResolveMaterials
+	// materials defined by none of them are undefined, the first library defining a material wins
+	void resolveMaterials(const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries);
+	// append textures & undefined materials of sorted materialIds, appended textures are sorted & unique
+	static void resolveMaterialIds(std::span<const uint32_t> materialIds, const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries,
+		std::vector<uint32_t>& textureIds, std::vector<uint32_t>& undefinedMaterialIds);
+	// distinct texture maps of the resolved materials
+	size_t getTextureCount() const;
+	// used materials missing from all libraries
+	size_t getUndefinedMaterialCount() const;
+	// sorted by name, ids depend on the order files were parsed in so they'd change with -threads/-jobs
+	std::vector<std::string_view> getUndefinedMaterialNames() const;
 
 	bool isEmpty() const;
 
+	// accumulate counts & materials of another collection of the same asset into this one
+	void merge(const PrimDataCollection& other);
+
 	// list property values to console
 	void debugPrint() const;
+};
+
+// variable length values per row, stored back to back
+template<typename T>
+struct RaggedColumn
+{
+	std::pmr::vector<T> values;
+	// end of each row in values
+	std::pmr::vector<uint64_t> rowEnds;
+
+	explicit RaggedColumn(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: values(resource)
+		, rowEnds(resource)
+	{}
+
+	std::span<const T> getRow(size_t row) const
+	{
+		const uint64_t rowStart = row == 0 ? 0 : rowEnds[row - 1];
+		return std::span<const T>(values.data() + rowStart, values.data() + rowEnds[row]);
+	}
+	void appendRow(std::span<const T> rowValues)
+	{
+		values.insert(values.end(), rowValues.begin(), rowValues.end());
+		rowEnds.push_back(values.size());
+	}
+	// rows of other from firstRow on
+	void appendRows(const RaggedColumn& other, size_t firstRow)
+	{
+		const uint64_t valueOffset = values.size();
+		const uint64_t otherRowStart = firstRow == 0 ? 0 : other.rowEnds[firstRow - 1];
+		values.insert(values.end(), other.values.begin() + otherRowStart, other.values.end());
+		for (size_t row = firstRow; row < other.rowEnds.size(); row++)
+		{
+			rowEnds.push_back(other.rowEnds[row] - otherRowStart + valueOffset);
+		}
+	}
+	void clear()
+	{
+		values.clear();
+		rowEnds.clear();
+	}
+};
+
+// closed collections of a file, stored column wise
+// each counter is a contiguous array & names, materials & textures are ragged columns,
+// so a million collections are a few dozen allocations instead of several per collection
+class PrimDataStore
+{
+	RaggedColumn<char> names;
+	RaggedColumn<uint32_t> materialIds;
+	RaggedColumn<uint32_t> textureIds;
+	RaggedColumn<uint32_t> undefinedMaterialIds;
+	// PrimDataCollection bitfield, same bits as the cache format
+	std::pmr::vector<uint8_t> flags;
+
+	// calls func(PrimDataStore column member, matching PrimDataCollection member) for each fixed size field
+	template<typename Func>
+	static void forEachColumn(Func&& func);
+
+public:
+	// one entry per row
+	std::pmr::vector<uint32_t> vertCounts;
+	std::pmr::vector<uint32_t> uniqueVertCounts;
+	std::pmr::vector<uint32_t> pointCounts;
+	std::pmr::vector<uint32_t> lineCounts;
+	std::pmr::vector<uint32_t> faceTotalCounts;
+	std::pmr::vector<uint32_t> faceTriCounts;
+	std::pmr::vector<uint32_t> faceQuadCounts;
+	std::pmr::vector<uint32_t> faceNgonCounts;
+	std::pmr::vector<uint32_t> faceTriEquivalentCounts;
+	std::pmr::vector<uint16_t> subgroupCounts;
+	std::pmr::vector<uint32_t> invalidFaceIndexCounts;
+	std::pmr::vector<uint32_t> degenerateFaceCounts;
+	std::pmr::vector<uint32_t> boundaryEdgeCounts;
+	std::pmr::vector<uint32_t> nonManifoldEdgeCounts;
+	std::pmr::vector<uint32_t> isolatedVertCounts;
+	std::pmr::vector<std::array<float, 3>> boundsMins;
+	std::pmr::vector<std::array<float, 3>> boundsMaxs;
+	std::pmr::vector<std::array<double, 3>> positionSums;
+	std::pmr::vector<uint32_t> boundedVertCounts;
+
+	// all columns allocate from resource
+	explicit PrimDataStore(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	size_t size() const;
+	bool empty() const;
+	void clear();
+
+	void append(const PrimDataCollection& collection);
+	// rows of other from firstRow on
+	void appendRows(const PrimDataStore& other, size_t firstRow = 0);
+	// overwrite collection with row, reusing its buffers
+	// outputters format rows through one such collection, as streamed collections never enter a store
+	void load(size_t row, PrimDataCollection& collection) const;
+
+	std::string_view getName(size_t row) const;
+	// sorted MaterialNameTable ids
+	std::span<const uint32_t> getMaterialIds(size_t row) const;
+
+	// PrimDataCollection::resolveMaterials() for every row
+	void resolveMaterials(const std::vector<std::shared_ptr<const MaterialLibrary>>& libraries);
+
+	// binary serialization in host byte order, column by column, used by the result cache
+	void writeTo(std::ostream& stream) const;
+	// returns false if stream ended or failed before all rows were read
+	bool readFrom(std::istream& stream);
 };
\ No newline at end of file
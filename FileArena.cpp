@@ -0,0 +1,58 @@
+#include "FileArena.h"
+
+#include <algorithm>
+#include <bit>
+
+FileArena::FileArena()
+{
+	resetBumpResource(minInitialBlockSize);
+};
+
+void FileArena::resetBumpResource(size_t blockSize)
+{
+	bumpResource.reset();
+	if (blockSize != initialBlockSize)
+	{
+		initialBlock = std::make_unique<std::byte[]>(blockSize);
+		initialBlockSize = blockSize;
+	}
+	bumpResource.emplace(initialBlock.get(), initialBlockSize, std::pmr::new_delete_resource());
+	bumpedSize = 0;
+};
+
+void* FileArena::do_allocate(size_t bytes, size_t alignment)
+{
+	if (bytes >= largeAllocationSize)
+	{
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	bumpedSize += bytes;
+	return bumpResource->allocate(bytes, alignment);
+};
+
+void FileArena::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	// bumped allocations are only freed by release()
+	if (bytes >= largeAllocationSize)
+	{
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+};
+
+bool FileArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+};
+
+void FileArena::release()
+{
+	if (bumpedSize > initialBlockSize && initialBlockSize < maxInitialBlockSize)
+	{
+		resetBumpResource(std::min(std::bit_ceil(bumpedSize), maxInitialBlockSize));
+	}
+	else
+	{
+		bumpResource->release();
+		bumpedSize = 0;
+	}
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// memory resource for the transient state of one file processor, released in one go once the file is output
+// small allocations are bumped from blocks that are only freed by release(), the first block is kept for the next file,
+// large allocations go to the heap & are freed individually, so vectors growing with the file don't strand their old buffers
+// not thread safe, only one processor may use it at a time
+class FileArena : public std::pmr::memory_resource
+{
+	std::unique_ptr<std::byte[]> initialBlock;
+	size_t initialBlockSize = 0;
+	// reconstructed when initialBlock grows, a monotonic_buffer_resource can't be given a new buffer
+	std::optional<std::pmr::monotonic_buffer_resource> bumpResource;
+	// bumped bytes since the last release()
+	size_t bumpedSize = 0;
+
+	static constexpr size_t minInitialBlockSize = 64 << 10; // 64 KiB
+	// files needing more than this don't keep it around for the next file
+	static constexpr size_t maxInitialBlockSize = 4 << 20; // 4 MiB
+	static constexpr size_t largeAllocationSize = 256 << 10; // 256 KiB
+
+	void resetBumpResource(size_t blockSize);
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+	FileArena();
+
+	FileArena(const FileArena&) = delete;
+	FileArena& operator=(const FileArena&) = delete;
+
+	// free everything bumped so far, all containers using the arena must be destroyed first
+	// grows the first block to the bumped size so a similar next file doesn't need more blocks
+	void release();
+};
@@ -0,0 +1,270 @@
+#include "InputReaders.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+InputFileReader::InputFileReader(const std::filesystem::path& filepath, bool bDecompress)
+{
+	open(filepath, bDecompress);
+};
+
+InputFileReader::~InputFileReader()
+{
+	close();
+};
+
+bool InputFileReader::open(const std::filesystem::path& filepath, bool bDecompress)
+{
+	close();
+	bHasFailed = false;
+	bIsStreamExhausted = false;
+
+	const CompressionFormat format = bDecompress ? getCompressionFormat(filepath) : CompressionFormat::None;
+	if (format != CompressionFormat::None)
+	{
+		bIsOpen = openDecompressed(filepath, format);
+		bHasFailed = !bIsOpen;
+		return bIsOpen;
+	}
+
+	if (openMapped(filepath) || openBuffered(filepath))
+	{
+		bIsOpen = true;
+		return true;
+	}
+	bHasFailed = true;
+	return false;
+};
+
+#ifdef _WIN32
+bool InputFileReader::openMapped(const std::filesystem::path& filepath)
+{
+	fileHandle = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		fileHandle = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (GetFileType(fileHandle) != FILE_TYPE_DISK || !GetFileSizeEx(fileHandle, &fileSize))
+	{
+		close();
+		return false;
+	}
+
+	// mapping empty files is not allowed, but there is nothing to read anyway
+	if (fileSize.QuadPart != 0)
+	{
+		mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		mappedData = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (mappedData == nullptr)
+		{
+			close();
+			return false;
+		}
+		mappedSize = size_t(fileSize.QuadPart);
+	}
+
+	bIsMapped = true;
+	cursor = mappedData;
+	dataEnd = mappedData + mappedSize;
+	return true;
+};
+#else
+bool InputFileReader::openMapped(const std::filesystem::path& filepath)
+{
+	fileDescriptor = ::open(filepath.c_str(), O_RDONLY);
+	if (fileDescriptor == -1)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+	{
+		close();
+		return false;
+	}
+
+	// mapping empty files is not allowed, but there is nothing to read anyway
+	if (fileStat.st_size != 0)
+	{
+		void* mapping = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+		// hint kernel to read ahead aggressively since file is scanned front to back
+		madvise(mapping, size_t(fileStat.st_size), MADV_SEQUENTIAL);
+
+		mappedData = static_cast<const char*>(mapping);
+		mappedSize = size_t(fileStat.st_size);
+	}
+
+	bIsMapped = true;
+	cursor = mappedData;
+	dataEnd = mappedData + mappedSize;
+	return true;
+};
+#endif
+
+bool InputFileReader::openBuffered(const std::filesystem::path& filepath)
+{
+	fileStream.open(filepath, std::ios::binary);
+	if (!fileStream.is_open())
+	{
+		return false;
+	}
+
+	buffer.resize(bufferBlockSize);
+	cursor = buffer.data();
+	dataEnd = buffer.data();
+	return true;
+};
+
+bool InputFileReader::openDecompressed(const std::filesystem::path& filepath, CompressionFormat format)
+{
+	decompressor = std::make_unique<BlockDecompressor>(filepath, format);
+	if (!decompressor->isOpen())
+	{
+		decompressor.reset();
+		return false;
+	}
+
+	buffer.resize(bufferBlockSize);
+	cursor = buffer.data();
+	dataEnd = buffer.data();
+	return true;
+};
+
+void InputFileReader::close()
+{
+#ifdef _WIN32
+	if (mappedData != nullptr)
+	{
+		UnmapViewOfFile(mappedData);
+	}
+	if (mappingHandle != nullptr)
+	{
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+	}
+	if (fileHandle != nullptr)
+	{
+		CloseHandle(fileHandle);
+		fileHandle = nullptr;
+	}
+#else
+	if (mappedData != nullptr)
+	{
+		munmap(const_cast<char*>(mappedData), mappedSize);
+	}
+	if (fileDescriptor != -1)
+	{
+		::close(fileDescriptor);
+		fileDescriptor = -1;
+	}
+#endif
+	mappedData = nullptr;
+	mappedSize = 0;
+
+	if (fileStream.is_open())
+	{
+		fileStream.close();
+	}
+	decompressor.reset();
+	buffer.clear();
+	buffer.shrink_to_fit();
+
+	cursor = nullptr;
+	dataEnd = nullptr;
+	bIsOpen = false;
+	bIsMapped = false;
+};
+
+bool InputFileReader::refillBuffer()
+{
+	if (bIsStreamExhausted || (!fileStream.is_open() && decompressor == nullptr))
+	{
+		return false;
+	}
+
+	// keep partial line at front of buffer
+	const size_t leftoverSize = dataEnd - cursor;
+	if (leftoverSize != 0 && cursor != buffer.data())
+	{
+		std::memmove(buffer.data(), cursor, leftoverSize);
+	}
+	// line longer than buffer, grow to fit another block
+	if (buffer.size() - leftoverSize < bufferBlockSize)
+	{
+		buffer.resize(leftoverSize + bufferBlockSize);
+	}
+
+	size_t readSize = 0;
+	if (decompressor != nullptr)
+	{
+		readSize = decompressor->read(buffer.data() + leftoverSize, buffer.size() - leftoverSize);
+		if (readSize != buffer.size() - leftoverSize)
+		{
+			bIsStreamExhausted = true;
+			bHasFailed = decompressor->hasFailed();
+		}
+	}
+	else
+	{
+		fileStream.read(buffer.data() + leftoverSize, std::streamsize(buffer.size() - leftoverSize));
+		readSize = size_t(fileStream.gcount());
+
+		if (!fileStream)
+		{
+			// short read is only expected at eof
+			bIsStreamExhausted = true;
+			bHasFailed = !fileStream.eof();
+		}
+	}
+
+	cursor = buffer.data();
+	dataEnd = buffer.data() + leftoverSize + readSize;
+	return readSize != 0;
+};
+
+bool InputFileReader::isOpen() const
+{
+	return bIsOpen;
+};
+
+bool InputFileReader::isMapped() const
+{
+	return bIsMapped;
+};
+
+bool InputFileReader::hasFailed() const
+{
+	return bHasFailed;
+};
+
+std::string_view InputFileReader::getMappedData() const
+{
+	if (bIsMapped && mappedData != nullptr)
+	{
+		return std::string_view(mappedData, mappedSize);
+	}
+	return {};
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "BlockDecompressor.h"
+#include "LineScanner.h"
+
+// splits next line without its line ending ("\n" or "\r\n") off the front of [cursor, dataEnd)
+// spaceCount is the number of ' ' in line, see findNewline()
+// returns false if no line ending was found, in which case line & cursor are left untouched
+inline bool splitLine(const char*& cursor, const char* dataEnd, std::string_view& line, uint32_t& spaceCount)
+{
+	const char* lineEnd = findNewline(cursor, dataEnd, spaceCount);
+	if (lineEnd == nullptr)
+	{
+		return false;
+	}
+
+	line = std::string_view(cursor, lineEnd);
+	cursor = lineEnd + 1;
+
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+	return true;
+}
+
+// splits remaining data as last line lacking a line ending
+// returns false if there is no data left
+inline bool splitLastLine(const char*& cursor, const char* dataEnd, std::string_view& line, uint32_t& spaceCount)
+{
+	if (cursor == dataEnd)
+	{
+		return false;
+	}
+
+	line = std::string_view(cursor, dataEnd);
+	cursor = dataEnd;
+	spaceCount = countSpaces(line.data(), line.data() + line.size());
+
+	if (line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+	return true;
+}
+
+// reads an input file line by line without copying,
+// lines are views into either the memory mapped file or an internal buffer
+// and are only valid until the next call to getLine()
+class InputFileReader
+{
+	// memory mapped input
+	const char* mappedData = nullptr;
+	size_t mappedSize = 0;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+
+	// buffered fallback for pipes & non mappable files
+	std::ifstream fileStream;
+	// replaces fileStream for compressed files, see getCompressionFormat()
+	std::unique_ptr<BlockDecompressor> decompressor;
+	std::vector<char> buffer;
+	static constexpr size_t bufferBlockSize = 1 << 20; // 1 MiB
+
+	// current read position & end of readable data
+	const char* cursor = nullptr;
+	const char* dataEnd = nullptr;
+
+	bool bIsOpen = false;
+	bool bIsMapped = false;
+	bool bHasFailed = false;
+	bool bIsStreamExhausted = false;
+
+	bool openMapped(const std::filesystem::path& filepath);
+	bool openBuffered(const std::filesystem::path& filepath);
+	bool openDecompressed(const std::filesystem::path& filepath, CompressionFormat format);
+
+	// moves unread data to the front of the buffer & reads the next block after it
+	// returns false if no new data could be read
+	bool refillBuffer();
+
+public:
+	InputFileReader() = default;
+	InputFileReader(const std::filesystem::path& filepath, bool bDecompress = true);
+	~InputFileReader();
+
+	InputFileReader(const InputFileReader&) = delete;
+	InputFileReader& operator=(const InputFileReader&) = delete;
+
+	// tries to memory map the file, falls back to buffered reads if not possible
+	// with bDecompress, compressed files are decompressed on a separate thread & read buffered
+	bool open(const std::filesystem::path& filepath, bool bDecompress = true);
+	void close();
+
+	bool isOpen() const;
+	bool isMapped() const;
+	// true if file could not be opened or a read failed before reaching eof
+	bool hasFailed() const;
+
+	// entire file content, only available when mapped
+	std::string_view getMappedData() const;
+
+	// get next line without its line ending ("\n" or "\r\n") & the number of ' ' in it
+	// returns false once all lines have been read
+	inline bool getLine(std::string_view& line, uint32_t& spaceCount);
+	inline bool getLine(std::string_view& line) { uint32_t spaceCount; return getLine(line, spaceCount); };
+};
+
+inline bool InputFileReader::getLine(std::string_view& line, uint32_t& spaceCount)
+{
+	while (!splitLine(cursor, dataEnd, line, spaceCount))
+	{
+		if (bIsMapped || !refillBuffer())
+		{
+			return splitLastLine(cursor, dataEnd, line, spaceCount);
+		}
+	}
+	return true;
+}
+
+// reads lines from an already loaded range of data, such as a chunk of a mapped file
+class InputChunkReader
+{
+	const char* cursor;
+	const char* dataEnd;
+
+public:
+	InputChunkReader(std::string_view data) : cursor(data.data()), dataEnd(data.data() + data.size()) {};
+
+	// get next line without its line ending ("\n" or "\r\n") & the number of ' ' in it
+	// returns false once all lines have been read
+	inline bool getLine(std::string_view& line, uint32_t& spaceCount)
+	{
+		return splitLine(cursor, dataEnd, line, spaceCount) || splitLastLine(cursor, dataEnd, line, spaceCount);
+	}
+	inline bool getLine(std::string_view& line) { uint32_t spaceCount; return getLine(line, spaceCount); };
+};
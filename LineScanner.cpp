@@ -0,0 +1,223 @@
+#include "LineScanner.h"
+
+#include <bit>
+
+// sse2 is part of the x86-64 baseline, so only 64 bit builds get vectorized kernels
+#if defined(__x86_64__) || defined(_M_X64)
+#define OBJANALYZER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// msvc allows avx2 intrinsics without enabling them for the whole translation unit
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// ---- scalar ----
+static uint32_t countSpacesScalar(const char* begin, const char* end)
+{
+	uint32_t spaceCount = 0;
+	for (const char* p = begin; p < end; p++)
+	{
+		spaceCount += *p == ' ';
+	}
+	return spaceCount;
+}
+
+static const char* findNewlineScalar(const char* begin, const char* end, uint32_t& spaceCount)
+{
+	uint32_t lineSpaceCount = 0;
+	for (const char* p = begin; p < end; p++)
+	{
+		if (*p == '\n')
+		{
+			spaceCount = lineSpaceCount;
+			return p;
+		}
+		lineSpaceCount += *p == ' ';
+	}
+	spaceCount = lineSpaceCount;
+	return nullptr;
+}
+
+#ifdef OBJANALYZER_X86
+// ---- sse2 ----
+static uint32_t countSpacesSse2(const char* begin, const char* end)
+{
+	const __m128i spaces = _mm_set1_epi8(' ');
+	uint32_t spaceCount = 0;
+
+	const char* p = begin;
+	// 32 bytes per itteration, as 2 blocks of 16
+	for (; end - p >= 32; p += 32)
+	{
+		const uint32_t maskLow  = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), spaces)));
+		const uint32_t maskHigh = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), spaces)));
+		spaceCount += std::popcount(maskLow | (maskHigh << 16));
+	}
+	for (; end - p >= 16; p += 16)
+	{
+		spaceCount += std::popcount(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), spaces))));
+	}
+	return spaceCount + countSpacesScalar(p, end);
+}
+
+// blocks are loaded from the line start on, so lines shorter than a block are still scanned vectorized
+static const char* findNewlineSse2(const char* begin, const char* end, uint32_t& spaceCount)
+{
+	const __m128i newlines = _mm_set1_epi8('\n');
+	const __m128i spaces = _mm_set1_epi8(' ');
+	uint32_t lineSpaceCount = 0;
+
+	const char* p = begin;
+	for (; end - p >= 16; p += 16)
+	{
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const uint32_t newlineMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines)));
+		const uint32_t spaceMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, spaces)));
+		if (newlineMask != 0)
+		{
+			// bits up to & including the first newline, which is no space
+			spaceCount = lineSpaceCount + std::popcount(spaceMask & (newlineMask ^ (newlineMask - 1)));
+			return p + std::countr_zero(newlineMask);
+		}
+		lineSpaceCount += std::popcount(spaceMask);
+	}
+	const char* newline = findNewlineScalar(p, end, spaceCount);
+	spaceCount += lineSpaceCount;
+	return newline;
+}
+
+// ---- avx2 ----
+TARGET_AVX2 static uint32_t countSpacesAvx2(const char* begin, const char* end)
+{
+	const __m256i spaces = _mm256_set1_epi8(' ');
+	uint32_t spaceCount = 0;
+
+	const char* p = begin;
+	// 64 bytes per itteration, as 2 blocks of 32
+	for (; end - p >= 64; p += 64)
+	{
+		const uint64_t maskLow  = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), spaces)));
+		const uint64_t maskHigh = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), spaces)));
+		spaceCount += std::popcount(maskLow | (maskHigh << 32));
+	}
+	for (; end - p >= 32; p += 32)
+	{
+		spaceCount += std::popcount(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), spaces))));
+	}
+	return spaceCount + countSpacesSse2(p, end);
+}
+
+TARGET_AVX2 static const char* findNewlineAvx2(const char* begin, const char* end, uint32_t& spaceCount)
+{
+	const __m256i newlines = _mm256_set1_epi8('\n');
+	const __m256i spaces = _mm256_set1_epi8(' ');
+	uint32_t lineSpaceCount = 0;
+
+	const char* p = begin;
+	for (; end - p >= 32; p += 32)
+	{
+		const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		const uint32_t newlineMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newlines)));
+		const uint32_t spaceMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, spaces)));
+		if (newlineMask != 0)
+		{
+			spaceCount = lineSpaceCount + std::popcount(spaceMask & (newlineMask ^ (newlineMask - 1)));
+			return p + std::countr_zero(newlineMask);
+		}
+		lineSpaceCount += std::popcount(spaceMask);
+	}
+	const char* newline = findNewlineSse2(p, end, spaceCount);
+	spaceCount += lineSpaceCount;
+	return newline;
+}
+#endif
+
+// ---- runtime dispatch ----
+static SimdLevel detectSimdLevel()
+{
+#ifdef OBJANALYZER_X86
+#ifdef _MSC_VER
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] >= 7)
+	{
+		__cpuid(cpuInfo, 1);
+		// avx2 also requires the os to save ymm registers (osxsave + xcr0 bits)
+		const bool hasOsAvxSupport = (cpuInfo[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+		__cpuidex(cpuInfo, 7, 0);
+		if (hasOsAvxSupport && (cpuInfo[1] & (1 << 5)))
+		{
+			return SimdLevel::Avx2;
+		}
+	}
+	return SimdLevel::Sse2;
+#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return SimdLevel::Avx2;
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return SimdLevel::Sse2;
+	}
+#endif
+#endif
+	return SimdLevel::Scalar;
+}
+
+struct SimdKernels
+{
+	SimdLevel level;
+	uint32_t (*countSpaces)(const char*, const char*);
+	const char* (*findNewline)(const char*, const char*, uint32_t&);
+};
+
+static SimdKernels selectSimdKernels()
+{
+	const SimdLevel level = detectSimdLevel();
+	switch (level)
+	{
+#ifdef OBJANALYZER_X86
+	case SimdLevel::Avx2: return { level, countSpacesAvx2, findNewlineAvx2 };
+	case SimdLevel::Sse2: return { level, countSpacesSse2, findNewlineSse2 };
+#endif
+	default:              return { SimdLevel::Scalar, countSpacesScalar, findNewlineScalar };
+	}
+}
+
+// function local so callers during static initialization of other translation units never see an unselected table
+static const SimdKernels& getSimdKernels()
+{
+	static const SimdKernels simdKernels = selectSimdKernels();
+	return simdKernels;
+}
+
+SimdLevel getSimdLevel()
+{
+	return getSimdKernels().level;
+}
+
+const char* getSimdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Avx2: return "AVX2";
+	case SimdLevel::Sse2: return "SSE2";
+	default:              return "scalar";
+	}
+}
+
+uint32_t countSpaces(const char* begin, const char* end)
+{
+	return getSimdKernels().countSpaces(begin, end);
+}
+
+const char* findNewline(const char* begin, const char* end, uint32_t& spaceCount)
+{
+	return getSimdKernels().findNewline(begin, end, spaceCount);
+}
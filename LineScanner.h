@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+// record types of obj lines relevant to processing
+enum class LineType : uint8_t
+{
+	Unknown, // comments, empty lines & unsupported records
+	Vertex,
+	VertexNormal,
+	VertexUv,
+	Face,
+	Point,
+	Line,
+	Object,
+	Group,
+	UseMaterial,
+	MaterialLibrary,
+};
+
+enum class SimdLevel : uint8_t
+{
+	Scalar,
+	Sse2,
+	Avx2,
+};
+
+// best instruction set supported by the running cpu, selected once on first use
+SimdLevel getSimdLevel();
+const char* getSimdLevelName(SimdLevel level);
+
+// count occurrences of ' ' in [begin, end)
+uint32_t countSpaces(const char* begin, const char* end);
+// first '\n' in [begin, end), nullptr if none
+// spaceCount is set to the number of ' ' before it, counted in the same block scan
+const char* findNewline(const char* begin, const char* end, uint32_t& spaceCount);
+
+// classify line by its record prefix (the chars before the first space)
+inline LineType classifyLine(std::string_view line)
+{
+	// pad with spaces so prefix checks never read past the line,
+	// a record prefix is always followed by a space or the end of line
+	auto charAt = [line](size_t i) { return i < line.size() ? line[i] : ' '; };
+
+	switch (charAt(0))
+	{
+	case 'v':
+		switch (charAt(1))
+		{
+		case ' ': return LineType::Vertex;
+		case 'n': return charAt(2) == ' ' ? LineType::VertexNormal : LineType::Unknown;
+		case 't': return charAt(2) == ' ' ? LineType::VertexUv : LineType::Unknown;
+		default:  return LineType::Unknown;
+		}
+	case 'f': return charAt(1) == ' ' ? LineType::Face   : LineType::Unknown;
+	case 'p': return charAt(1) == ' ' ? LineType::Point  : LineType::Unknown;
+	case 'l': return charAt(1) == ' ' ? LineType::Line   : LineType::Unknown;
+	case 'o': return charAt(1) == ' ' ? LineType::Object : LineType::Unknown;
+	case 'g': return charAt(1) == ' ' ? LineType::Group  : LineType::Unknown;
+	case 'u':
+		return line.size() >= 6 && std::memcmp(line.data(), "usemtl", 6) == 0 && charAt(6) == ' '
+			? LineType::UseMaterial
+			: LineType::Unknown;
+	case 'm':
+		return line.size() >= 6 && std::memcmp(line.data(), "mtllib", 6) == 0 && charAt(6) == ' '
+			? LineType::MaterialLibrary
+			: LineType::Unknown;
+	default:
+		return LineType::Unknown;
+	}
+}
+
+// non allocating range over the space separated values of a line, excluding its record prefix
+// ex: "f 1/1 2/2 3/3" -> "1/1", "2/2", "3/3"
+class LineValues
+{
+	std::string_view valuesStr;
+
+public:
+	class Iterator
+	{
+		const char* valueEnd;
+		const char* dataEnd;
+		std::string_view value;
+
+		// skip delimiters & find end of next value
+		inline void advance(const char* from)
+		{
+			while (from != dataEnd && *from == ' ') { from++; }
+			valueEnd = from;
+			while (valueEnd != dataEnd && *valueEnd != ' ') { valueEnd++; }
+			value = std::string_view(from, valueEnd);
+		}
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::string_view*;
+		using reference = const std::string_view&;
+
+		Iterator() : valueEnd(nullptr), dataEnd(nullptr) {};
+		Iterator(const char* begin, const char* end) : dataEnd(end) { advance(begin); };
+
+		reference operator*() const { return value; };
+		pointer operator->() const { return &value; };
+		Iterator& operator++() { advance(valueEnd); return *this; };
+		Iterator operator++(int) { Iterator previous = *this; advance(valueEnd); return previous; };
+
+		// exhausted once no value is left
+		bool operator==(const Iterator& other) const { return value.empty() ? other.value.empty() : value.data() == other.value.data(); };
+	};
+
+	LineValues(std::string_view line) : valuesStr(line.substr(std::min(line.find(' '), line.size()))) {};
+
+	Iterator begin() const { return Iterator(valuesStr.data(), valuesStr.data() + valuesStr.size()); };
+	Iterator end() const { return Iterator(); };
+
+	bool empty() const { return begin()->empty(); };
+	// empty if there are no values
+	std::string_view front() const { return *begin(); };
+	// walks all values
+	size_t size() const { return size_t(std::distance(begin(), end())); };
+};
@@ -26,9 +26,26 @@ void Logger::close()
 	bWriteToFile = false;
 };
 
+void Logger::enableCapture()
+{
+	bWriteToCapture = true;
+	bWriteToConsole = false;
+};
+
+std::string Logger::takeCapture()
+{
+	std::string capture = std::move(captureStream).str();
+	captureStream.str({});
+	return capture;
+};
+
 template<typename T>
 Logger& Logger::operator<<(const T& data)
 {
+	if (bWriteToCapture)
+	{
+		captureStream << data;
+	}
 	if (bWriteToFile)
 	{
 		fileWriteStream << data;
@@ -46,8 +63,40 @@ Logger& Logger::operator<<(LoggerManip manip)
 	return manip(*this);
 };
 
+void Logger::write(std::string_view text)
+{
+	if (bWriteToCapture)
+	{
+		captureStream << text;
+	}
+	if (bWriteToFile)
+	{
+		fileWriteStream << text;
+	}
+	if (bWriteToConsole)
+	{
+		std::cout << text;
+	}
+};
+
+void Logger::flush()
+{
+	if (bWriteToFile)
+	{
+		fileWriteStream.flush();
+	}
+	if (bWriteToConsole)
+	{
+		std::cout.flush();
+	}
+};
+
 Logger& Logger::endl(Logger& logger) //TODO: confirm no need for static
 {
+	if (logger.bWriteToCapture)
+	{
+		logger.captureStream << '\n';
+	}
 	if (logger.bWriteToFile)
 	{
 		logger.fileWriteStream << std::endl;
@@ -59,6 +108,88 @@ Logger& Logger::endl(Logger& logger) //TODO: confirm no need for static
 	return logger;
 };
 
+// --------------------------------
+void ProcessingWarningTally::add(uint64_t lineNum)
+{
+	if (count == 0)
+	{
+		firstLineNum = lineNum;
+	}
+	lastLineNum = lineNum;
+	count++;
+};
+
+void ProcessingWarningTally::merge(const ProcessingWarningTally& other)
+{
+	if (other.count == 0)
+	{
+		return;
+	}
+	if (count == 0)
+	{
+		firstLineNum = other.firstLineNum;
+	}
+	lastLineNum = other.lastLineNum;
+	count += other.count;
+};
+
+// --------------------------------
+LogRecordQueue::LogRecordQueue(size_t capacity) : indexMask(capacity - 1), slots(std::make_unique<Slot[]>(capacity))
+{
+	for (size_t i = 0; i < capacity; i++)
+	{
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+};
+
+bool LogRecordQueue::tryPush(LogRecord& record, uint64_t& pos)
+{
+	pos = enqueuePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Slot& slot = slots[pos & indexMask];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence == pos)
+		{
+			// slot free, claim it, on failure pos is reloaded
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				slot.record = std::move(record);
+				slot.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (sequence < pos)
+		{
+			// slot still holds a record from the previous lap
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+};
+
+bool LogRecordQueue::tryPop(LogRecord& record)
+{
+	Slot& slot = slots[dequeuePos & indexMask];
+	if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+	{
+		return false;
+	}
+	record = std::move(slot.record);
+	// free slot for the next lap
+	slot.sequence.store(dequeuePos + indexMask + 1, std::memory_order_release);
+	dequeuePos++;
+	return true;
+};
+
+uint64_t LogRecordQueue::getPushedCount() const
+{
+	return enqueuePos.load(std::memory_order_acquire);
+};
+
 // --------------------------------
 LoggedErrorException::LoggedErrorException(const std::string& msg) : msg(msg) {};
 
@@ -77,45 +208,239 @@ LogManager::LogManager(const std::filesystem::path& logFilePath)
 	}
 };
 
-LogManager::~LogManager() { logger.close(); };
+LogManager::~LogManager()
+{
+	stopAsync();
+	logger.close();
+};
 
 void LogManager::enableLoggingToFile(const std::filesystem::path& logFilePath)
 {
 	if (!logFilePath.empty())
 	{
+		// writer thread is idle once flushed, so the logger can be changed safely
+		flush();
 		logger.open(logFilePath, std::ios::app);
 	}
 };
 
 void LogManager::disableLoggingToFile()
 {
+	flush();
 	logger.close();
 };
 
-void LogManager::log(const std::pair<logVerbosity, std::string>& msg, bool terminateOnError)
+void LogManager::enableCapture()
+{
+	logger.enableCapture();
+};
+
+std::string LogManager::takeCapturedLog()
 {
-	// prefix with log type
-	switch (msg.first)
+	return logger.takeCapture();
+};
+
+void LogManager::logCaptured(const std::string& capturedLog)
+{
+	if (!capturedLog.empty())
 	{
-	case logVerbosity::Log:
-		logger << "Log: ";
-		break;
-	case logVerbosity::Warning:
-		logger << "Warning: ";
+		if (asyncQueue)
+		{
+			pushAsync({ .kind = LogRecord::Kind::Raw, .text = capturedLog });
+			return;
+		}
+		logger << capturedLog;
+	}
+};
+
+void LogManager::enableAsync()
+{
+	if (!asyncQueue)
+	{
+		asyncQueue = std::make_unique<LogRecordQueue>(asyncQueueCapacity);
+		asyncWriterThread = std::thread(&LogManager::asyncWriterLoop, this);
+	}
+};
+
+void LogManager::flush()
+{
+	if (!asyncQueue)
+	{
+		logger.flush();
+		return;
+	}
+
+	const uint64_t pushedCount = asyncQueue->getPushedCount();
+	uint64_t flushedCount = asyncFlushedCount.load(std::memory_order_acquire);
+	if (flushedCount >= pushedCount)
+	{
+		return;
+	}
+
+	bAsyncFlushRequested.store(true, std::memory_order_release);
+	asyncWakeSignal.fetch_add(1, std::memory_order_release);
+	asyncWakeSignal.notify_one();
+	while (flushedCount < pushedCount)
+	{
+		asyncFlushedCount.wait(flushedCount, std::memory_order_acquire);
+		flushedCount = asyncFlushedCount.load(std::memory_order_acquire);
+	}
+};
+
+void LogManager::pushAsync(LogRecord&& record)
+{
+	uint64_t pos;
+	while (!asyncQueue->tryPush(record, pos))
+	{
+		// full, let the writer thread catch up
+		asyncWakeSignal.fetch_add(1, std::memory_order_release);
+		asyncWakeSignal.notify_one();
+		std::this_thread::yield();
+	}
+	asyncWakeSignal.fetch_add(1, std::memory_order_release);
+	asyncWakeSignal.notify_one();
+};
+
+void LogManager::stopAsync()
+{
+	if (asyncQueue)
+	{
+		// writer drains the queue before exiting
+		bAsyncStopping.store(true, std::memory_order_release);
+		asyncWakeSignal.fetch_add(1, std::memory_order_release);
+		asyncWakeSignal.notify_one();
+		asyncWriterThread.join();
+		asyncQueue.reset();
+	}
+};
+
+void LogManager::asyncWriterLoop()
+{
+	LogRecord record;
+	std::string batch;
+	uint64_t writtenCount = 0;
+	uint64_t flushedCount = 0;
+	size_t unflushedSize = 0;
+	std::chrono::steady_clock::time_point lastFlushTime;
+
+	while (true)
+	{
+		// read before draining, so a push during the drain prevents sleeping below
+		const uint32_t wakeSignal = asyncWakeSignal.load(std::memory_order_acquire);
+		const bool bIsStopping = bAsyncStopping.load(std::memory_order_acquire);
+		// records pushed before the request are drained below
+		const bool bIsFlushRequested = bAsyncFlushRequested.exchange(false, std::memory_order_acq_rel);
+
+		while (asyncQueue->tryPop(record))
+		{
+			appendFormattedRecord(batch, record);
+			writtenCount++;
+			if (batch.size() >= asyncBatchSize)
+			{
+				logger.write(batch);
+				unflushedSize += batch.size();
+				batch.clear();
+			}
+		}
+		if (!batch.empty())
+		{
+			logger.write(batch);
+			unflushedSize += batch.size();
+			batch.clear();
+		}
+
+		const bool bIsStopped = bIsStopping && writtenCount == asyncQueue->getPushedCount();
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (writtenCount != flushedCount
+			&& (bIsFlushRequested || bIsStopped || unflushedSize >= asyncFlushSize || now - lastFlushTime >= asyncFlushInterval)
+			)
+		{
+			logger.flush();
+			unflushedSize = 0;
+			lastFlushTime = now;
+			flushedCount = writtenCount;
+			asyncFlushedCount.store(flushedCount, std::memory_order_release);
+			asyncFlushedCount.notify_all();
+		}
+
+		if (bIsStopped)
+		{
+			return;
+		}
+
+		if (writtenCount != flushedCount)
+		{
+			// pending output is flushed by the next pass once the interval is reached, unless records or a request come first
+			while (asyncWakeSignal.load(std::memory_order_acquire) == wakeSignal
+				&& std::chrono::steady_clock::now() - lastFlushTime < asyncFlushInterval
+				)
+			{
+				std::this_thread::sleep_for(asyncFlushPollInterval);
+			}
+			continue;
+		}
+		asyncWakeSignal.wait(wakeSignal, std::memory_order_acquire);
+	}
+};
+
+void LogManager::appendFormattedRecord(std::string& output, const LogRecord& record) const
+{
+	switch (record.kind)
+	{
+	case LogRecord::Kind::Message:
+		output += getVerbosityPrefix(record.verbosity);
+		output += record.text;
+		output += '\n';
 		break;
-	case logVerbosity::Error:
-		logger << "Error: ";
+	case LogRecord::Kind::Raw:
+		output += record.text;
 		break;
-	default:
+	case LogRecord::Kind::ProcessingPreset:
+		output += getVerbosityPrefix(record.verbosity);
+		// preset exists, checked when queued
+		std::vformat_to(std::back_inserter(output), std::string_view(logPresetToMsgProcessing.at(record.processingCode).second), std::make_format_args(record.lineNum));
+		output += '\n';
 		break;
 	}
-	// log actual message
-	logger << msg.second << logger.endl;
+};
+
+std::string_view LogManager::getVerbosityPrefix(logVerbosity verbosity)
+{
+	switch (verbosity)
+	{
+	case logVerbosity::Log:     return "Log: ";
+	case logVerbosity::Warning: return "Warning: ";
+	case logVerbosity::Error:   return "Error: ";
+	default:                    return {};
+	}
+};
+
+void LogManager::handleError(logVerbosity verbosity, bool terminateOnError)
+{
+	if (verbosity == logVerbosity::Error)
+	{
+		// errors must be visible before exiting
+		flush();
+		if (terminateOnError)
+		{
+			throw LoggedErrorException("\nError occurred, see logs for details. \n Exiting...");
+		}
+	}
+};
 
-	if (terminateOnError && msg.first == logVerbosity::Error)
+void LogManager::log(const std::pair<logVerbosity, std::string>& msg, bool terminateOnError)
+{
+	if (asyncQueue)
+	{
+		pushAsync({ .kind = LogRecord::Kind::Message, .verbosity = msg.first, .text = msg.second });
+	}
+	else
 	{
-		throw LoggedErrorException("\nError occurred, see logs for details. \n Exiting...");
+		// log actual message
+		logger << getVerbosityPrefix(msg.first) << msg.second << logger.endl;
 	}
+
+	handleError(msg.first, terminateOnError);
 };
 
 void LogManager::logProgramArgs(const int& argc, char* argv[]) // TODO: replace with logging after progessing?
@@ -165,6 +490,24 @@ void LogManager::logMsgIo(const LogPresetIo& code, const std::filesystem::path f
 	}
 };
 
+void LogManager::logMsgIo(const LogPresetIo& code, const uint64_t& firstCount, const uint64_t& secondCount)
+{
+	auto it = logPresetToMsgIO.find(code);
+	if (it != logPresetToMsgIO.end())
+	{
+		const std::pair<logVerbosity, std::string> formattedMsg =
+		{
+			it->second.first,
+			std::vformat(std::string_view(it->second.second), std::make_format_args(firstCount, secondCount))
+		};
+		log(formattedMsg);
+	}
+	else
+	{
+		log({ logVerbosity::Error, "Unknown io error." });
+	}
+};
+
 void LogManager::logMsgProcessing(const LogPresetProcessing& code, const std::string_view value)
 {
 	auto it = logPresetToMsgProcessing.find(code);
@@ -186,7 +529,23 @@ void LogManager::logMsgProcessing(const LogPresetProcessing& code, const std::st
 void LogManager::logMsgProcessing(const LogPresetProcessing& code, const uint64_t& lineNum)
 {
 	auto it = logPresetToMsgProcessing.find(code);
-	if (it != logPresetToMsgProcessing.end())
+	if (it != logPresetToMsgProcessing.end() && it->second.first == logVerbosity::Warning)
+	{
+		ProcessingWarningTally& tally = processingWarningTallies[code];
+		tally.add(lineNum);
+		if (processingWarningLimit != 0 && tally.count > processingWarningLimit)
+		{
+			return;
+		}
+	}
+
+	if (it != logPresetToMsgProcessing.end() && asyncQueue)
+	{
+		// per line warnings, formatting is left to the writer thread
+		pushAsync({ .kind = LogRecord::Kind::ProcessingPreset, .verbosity = it->second.first, .processingCode = code, .lineNum = lineNum, .text = {} });
+		handleError(it->second.first, true);
+	}
+	else if (it != logPresetToMsgProcessing.end())
 	{
 		const std::pair<logVerbosity, std::string> formattedMsg =
 		{
@@ -217,4 +576,37 @@ void LogManager::logMsgProcessing(const LogPresetProcessing& code, const std::ch
 	{
 		log({ logVerbosity::Error, "Unknown processing error." });
 	}
+};
+
+void LogManager::setProcessingWarningLimit(uint32_t limit)
+{
+	processingWarningLimit = limit;
+};
+
+uint32_t LogManager::getProcessingWarningLimit() const
+{
+	return processingWarningLimit;
+};
+
+void LogManager::addSuppressedProcessingWarnings(const LogPresetProcessing& code, const ProcessingWarningTally& tally)
+{
+	processingWarningTallies[code].merge(tally);
+};
+
+void LogManager::logProcessingWarningSummary()
+{
+	const std::string& summaryTemplate = logPresetToMsgProcessing.at(LogPresetProcessing::ProcessingWarningsSuppressed_warn).second;
+	for (const auto& [code, tally] : processingWarningTallies)
+	{
+		if (processingWarningLimit == 0 || tally.count <= processingWarningLimit)
+		{
+			continue;
+		}
+
+		// first occurrence as example of the suppressed warnings
+		const std::string example = std::vformat(std::string_view(logPresetToMsgProcessing.at(code).second), std::make_format_args(tally.firstLineNum));
+		const uint64_t suppressedCount = tally.count - processingWarningLimit;
+		log({ logVerbosity::Warning, std::vformat(std::string_view(summaryTemplate), std::make_format_args(suppressedCount, example, tally.count, tally.lastLineNum)) });
+	}
+	processingWarningTallies.clear();
 };
\ No newline at end of file
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <map>
 #include <format>
 #include <chrono>
 #include <exception>
+#include <memory>
+#include <thread>
 
 enum class logVerbosity : uint8_t
 {
@@ -33,6 +37,9 @@ enum class LogPresetProgramArg : uint8_t
 	BudgetOptions_log,
 	boolValueInvalid_warn,
 	ValidateOptions_log,
+	FailFastIgnored_warn,
+	StreamIgnored_warn,
+	CacheIgnored_warn,
 };
 
 enum class LogPresetIo : uint8_t
@@ -49,7 +56,14 @@ enum class LogPresetIo : uint8_t
 	LogPathWrite_log,
 	CsvFileAlreadyExists_warn,
 	CsvFileWriteFail_err,
+	CsvHeaderMismatch_err,
 	CsvPathWrite_log,
+	CacheHit_log,
+	CacheWriteFail_warn,
+	CacheStats_log,
+	StatsFileWriteFail_warn,
+	StatsPathWrite_log,
+	MtlFileReadFail_warn,
 };
 
 enum class LogPresetProcessing : uint8_t
@@ -60,16 +74,22 @@ enum class LogPresetProcessing : uint8_t
 	ONameMoreThanOne_warn,
 	GNameMissing_warn,
 	GNameMoreThanOne_warn,
+	VertexPositionInvalid_warn,
+	UniqueVertexCapReached_warn,
 	ProcessingStart_log,
 	ProcessingEnd_log,
 	ProcessingEndStats_log,
+	ProcessingFailFast_log,
+	ProcessingWarningsSuppressed_warn,
 };
 
 class Logger
 {
 	std::ofstream fileWriteStream;
+	std::ostringstream captureStream;
 	bool bWriteToFile = false;
 	bool bWriteToConsole = false;
+	bool bWriteToCapture = false;
 
 public:
 	Logger(bool enableWriteToConsole = true);
@@ -78,6 +98,14 @@ public:
 	void open(const std::filesystem::path& filepath, std::ios_base::openmode openmode);
 	void close();
 
+	// hold output in memory instead of writing to console, see takeCapture()
+	void enableCapture();
+	std::string takeCapture();
+
+	// write preformatted text to all outputs without flushing, used by the async writer for whole batches
+	void write(std::string_view text);
+	void flush();
+
 	template<typename T>
 	Logger& operator<<(const T& data);
 
@@ -89,6 +117,64 @@ public:
 	static Logger& endl(Logger& logger);
 };
 
+// occurrences of a processing warning within a file
+struct ProcessingWarningTally
+{
+	uint64_t count = 0;
+	uint64_t firstLineNum = 0;
+	uint64_t lastLineNum = 0;
+
+	void add(uint64_t lineNum);
+	// other must hold later occurrences than this
+	void merge(const ProcessingWarningTally& other);
+};
+
+// message queued for the async writer thread
+struct LogRecord
+{
+	enum class Kind : uint8_t
+	{
+		Message,           // text prefixed by verbosity & terminated by newline
+		Raw,               // text written as is, ex: captured output
+		ProcessingPreset,  // processingCode & lineNum, formatted by the writer thread
+	};
+
+	Kind kind = Kind::Message;
+	logVerbosity verbosity = logVerbosity::None;
+	LogPresetProcessing processingCode = LogPresetProcessing::GenericMissingValues_warn;
+	uint64_t lineNum = 0;
+	std::string text;
+};
+
+// bounded lock-free multi producer single consumer ring buffer
+// each slot's sequence number tells whether it is free to write (== pos) or ready to read (== pos + 1)
+class LogRecordQueue
+{
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence;
+		LogRecord record;
+	};
+
+	const uint64_t indexMask;
+	std::unique_ptr<Slot[]> slots;
+	// separate cache lines, written by producers & consumer respectively
+	alignas(64) std::atomic<uint64_t> enqueuePos = 0;
+	alignas(64) uint64_t dequeuePos = 0;
+
+public:
+	// capacity must be a power of 2
+	LogRecordQueue(size_t capacity);
+
+	// returns false if full, else sets pos to the position record was queued at
+	bool tryPush(LogRecord& record, uint64_t& pos);
+	// consumer thread only, returns false if empty or next record is not fully pushed yet
+	bool tryPop(LogRecord& record);
+
+	// number of positions reserved by producers so far
+	uint64_t getPushedCount() const;
+};
+
 class LoggedErrorException
 {
 	const std::string msg;
@@ -117,6 +203,9 @@ class LogManager
 		{ LogPresetProgramArg::BudgetOptions_log,     { logVerbosity::Log     , "Budget options overview: {0}" }},
 		{ LogPresetProgramArg::boolValueInvalid_warn, { logVerbosity::Error   , "'{0}' is not a valid bool value." }},
 		{ LogPresetProgramArg::ValidateOptions_log,   { logVerbosity::Log     , "Validation options overview: {0}" }},
+		{ LogPresetProgramArg::FailFastIgnored_warn,  { logVerbosity::Warning , "'-failfast' only applies to '-mode budget' with '-group file', ignoring." }},
+		{ LogPresetProgramArg::StreamIgnored_warn,    { logVerbosity::Warning , "'-stream' can't be combined with '-jobs', ignoring." }},
+		{ LogPresetProgramArg::CacheIgnored_warn,     { logVerbosity::Warning , "'-cache' can't be combined with material resolving, ignoring." }},
 	};
 
 	// pre-defined messages for specific logs
@@ -134,7 +223,14 @@ class LogManager
 		{ LogPresetIo::LogPathWrite_log,          { logVerbosity::Log,     "Writing to log file '{0}'." }},
 		{ LogPresetIo::CsvFileAlreadyExists_warn, { logVerbosity::Warning, "Specified csv file aleady exists '{0}', appending..." }},
 		{ LogPresetIo::CsvFileWriteFail_err,      { logVerbosity::Error,   "Failed to write to csv file '{0}'." }},
+		{ LogPresetIo::CsvHeaderMismatch_err,     { logVerbosity::Error,   "Csv file '{0}' has other columns than this run writes, appending would misalign them. Use another csv file." }},
 		{ LogPresetIo::CsvPathWrite_log,          { logVerbosity::Log,     "Writing to csv file '{0}'." }},
+		{ LogPresetIo::CacheHit_log,              { logVerbosity::Log,     "Using cached results for '{0}'." }},
+		{ LogPresetIo::CacheWriteFail_warn,       { logVerbosity::Warning, "Failed to write cache entry for '{0}'." }},
+		{ LogPresetIo::CacheStats_log,            { logVerbosity::Log,     "Result cache: {0} hits, {1} misses." }},
+		{ LogPresetIo::StatsFileWriteFail_warn,   { logVerbosity::Warning, "Failed to write stats file '{0}'." }},
+		{ LogPresetIo::StatsPathWrite_log,        { logVerbosity::Log,     "Writing stats to '{0}'." }},
+		{ LogPresetIo::MtlFileReadFail_warn,      { logVerbosity::Warning, "Failed to read material library '{0}', its materials count as undefined." }},
 	};
 
 	// pre-defined messages for specific logs
@@ -146,9 +242,13 @@ class LogManager
 		{ LogPresetProcessing::ONameMoreThanOne_warn,     { logVerbosity::Warning, "Line {0} : Object has more than 1 name." }},
 		{ LogPresetProcessing::GNameMissing_warn,         { logVerbosity::Warning, "Line {0} : Group missing name." }},
 		{ LogPresetProcessing::GNameMoreThanOne_warn,     { logVerbosity::Warning, "Line {0} : Prims belong to multiple groups.Only processing first." }},
+		{ LogPresetProcessing::VertexPositionInvalid_warn, { logVerbosity::Warning, "Line {0} : Invalid vertex position, excluded from bounds & unique vertex count." }},
+		{ LogPresetProcessing::UniqueVertexCapReached_warn, { logVerbosity::Warning, "Line {0} : Unique vertex memory cap reached, unique vertex count is an upper bound from here on." }},
 		{ LogPresetProcessing::ProcessingStart_log,       { logVerbosity::Log,     "---- Begining File Processing ----" }},
 		{ LogPresetProcessing::ProcessingEnd_log,         { logVerbosity::Log,     "---- Finished Processing File ----\n" }},
 		{ LogPresetProcessing::ProcessingEndStats_log,    { logVerbosity::Log,     "Processed {0} lines in {1} ms." }},
+		{ LogPresetProcessing::ProcessingFailFast_log,    { logVerbosity::Log,     "Line {0} : All budgets exceeded, stopped reading early. Counts are partial." }},
+		{ LogPresetProcessing::ProcessingWarningsSuppressed_warn, { logVerbosity::Warning, "{0} more warnings like '{1}' not shown ({2} total, last on line {3})." }},
 	};
 
 	const std::string helpMsg = "Help:\n"
@@ -157,6 +257,41 @@ class LogManager
 
 	Logger logger;
 
+	// async backend, see enableAsync()
+	static constexpr size_t asyncQueueCapacity = 4096;
+	// large batches are written before the queue is fully drained
+	static constexpr size_t asyncBatchSize = 64 << 10; // 64 KiB
+	// written output is flushed once this much is pending or the last flush is this old, or on flush() & stop
+	static constexpr size_t asyncFlushSize = 256 << 10; // 256 KiB
+	static constexpr std::chrono::milliseconds asyncFlushInterval{ 100 };
+	// while output is pending, the writer checks for new records this often until the flush interval is reached
+	static constexpr std::chrono::milliseconds asyncFlushPollInterval{ 2 };
+	std::unique_ptr<LogRecordQueue> asyncQueue;
+	std::thread asyncWriterThread;
+	// records popped, written & flushed by the writer thread
+	std::atomic<uint64_t> asyncFlushedCount = 0;
+	// bumped on each push, flush request & on stop, writer thread sleeps on it when the queue is empty
+	std::atomic<uint32_t> asyncWakeSignal = 0;
+	std::atomic<bool> bAsyncStopping = false;
+	// set by flush(), the writer flushes right after draining instead of waiting for a threshold
+	std::atomic<bool> bAsyncFlushRequested = false;
+
+	// warnings past the limit are only counted, 0 = unlimited
+	uint32_t processingWarningLimit = 0;
+	// per file, reset by logProcessingWarningSummary()
+	std::map<LogPresetProcessing, ProcessingWarningTally> processingWarningTallies;
+
+	void asyncWriterLoop();
+	// queue record for the writer thread, blocks while the queue is full
+	void pushAsync(LogRecord&& record);
+	void stopAsync();
+	void appendFormattedRecord(std::string& output, const LogRecord& record) const;
+
+	// prefix with log type
+	static std::string_view getVerbosityPrefix(logVerbosity verbosity);
+	// flush & throw if msg is an error that should terminate
+	void handleError(logVerbosity verbosity, bool terminateOnError);
+
 public:
 	LogManager();
 	LogManager(const std::filesystem::path& logFilePath);
@@ -165,6 +300,19 @@ public:
 	void enableLoggingToFile(const std::filesystem::path& logFilePath);
 	void disableLoggingToFile();
 
+	// hold all output in memory, used to keep output of concurrently processed files from interleaving
+	void enableCapture();
+	// returns & clears output held since enableCapture()
+	std::string takeCapturedLog();
+	// write output previously taken from another capturing log manager
+	void logCaptured(const std::string& capturedLog);
+
+	// format & write messages on a background thread in batches, flushed by size or age instead of per message
+	// errors are still flushed before LoggedErrorException is thrown
+	void enableAsync();
+	// blocks until every message logged so far is written & flushed
+	void flush();
+
 	void logProgramArgs(const int& argc, char* argv[]); // TODO: possible remove or rename
 
 	// logs string with verbosity level
@@ -175,9 +323,20 @@ public:
 	// format and log based on mappings
 	void logMsgIo(const LogPresetIo& code, const std::filesystem::path filepath = {});
 	// format and log based on mappings
+	void logMsgIo(const LogPresetIo& code, const uint64_t& firstCount, const uint64_t& secondCount);
+	// format and log based on mappings
 	void logMsgProcessing(const LogPresetProcessing& code, const std::string_view value = {});
 	// format and log based on mappings
+	// warnings past the processing warning limit are only counted, see logProcessingWarningSummary()
 	void logMsgProcessing(const LogPresetProcessing& code, const uint64_t& lineNum);
 	// format and log based on mappings
 	void logMsgProcessing(const LogPresetProcessing& code, const std::chrono::milliseconds& time, uint64_t& lineCount);
+
+	// show only the first limit occurrences of each processing warning per file, 0 = unlimited
+	void setProcessingWarningLimit(uint32_t limit);
+	uint32_t getProcessingWarningLimit() const;
+	// count warnings that were held back by a chunk processor, see FileProcessor::mergeChunk()
+	void addSuppressedProcessingWarnings(const LogPresetProcessing& code, const ProcessingWarningTally& tally);
+	// log count of warnings not shown since last summary, call once per file
+	void logProcessingWarningSummary();
 };
\ No newline at end of file
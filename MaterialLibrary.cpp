@@ -0,0 +1,195 @@
+#include "MaterialLibrary.h"
+
+#include "InputReaders.h"
+#include "MaterialNameTable.h"
+
+#include <algorithm>
+#include <charconv>
+
+// statement separators, mtl files from some exporters use tabs
+static constexpr std::string_view whitespace = " \t";
+
+static std::string_view trimWhitespace(std::string_view text)
+{
+	const size_t start = text.find_first_not_of(whitespace);
+	if (start == text.npos)
+	{
+		return std::string_view();
+	}
+	return text.substr(start, text.find_last_not_of(whitespace) + 1 - start);
+}
+
+// split off the first whitespace separated token of text
+static std::string_view takeToken(std::string_view& text)
+{
+	text = trimWhitespace(text);
+	const size_t tokenEnd = std::min(text.find_first_of(whitespace), text.size());
+	const std::string_view token = text.substr(0, tokenEnd);
+	text.remove_prefix(tokenEnd);
+	return token;
+}
+
+static bool isNumber(std::string_view token)
+{
+	float value;
+	const auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+	return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+// options come first & take a fixed number of arguments, except -o, -s & -t which take 1 to 3 numbers,
+// the rest of the statement is the path, which may contain spaces
+// empty if there is no path
+static std::string_view getTexturePath(std::string_view arguments)
+{
+	struct TextureOption
+	{
+		std::string_view name;
+		uint32_t minArgCount;
+		uint32_t maxArgCount;
+	};
+	static constexpr TextureOption textureOptions[] = {
+		{ "-blendu",  1, 1 },
+		{ "-blendv",  1, 1 },
+		{ "-bm",      1, 1 },
+		{ "-boost",   1, 1 },
+		{ "-cc",      1, 1 },
+		{ "-clamp",   1, 1 },
+		{ "-imfchan", 1, 1 },
+		{ "-mm",      2, 2 },
+		{ "-o",       1, 3 },
+		{ "-s",       1, 3 },
+		{ "-t",       1, 3 },
+		{ "-texres",  1, 1 },
+		{ "-type",    1, 1 },
+	};
+
+	arguments = trimWhitespace(arguments);
+	while (arguments.starts_with('-'))
+	{
+		std::string_view remaining = arguments;
+		const std::string_view optionName = takeToken(remaining);
+		const TextureOption* option = std::find_if(std::begin(textureOptions), std::end(textureOptions), [optionName](const TextureOption& option) { return option.name == optionName; });
+		if (option == std::end(textureOptions))
+		{
+			// unknown option, so the path starts with '-'
+			break;
+		}
+		for (uint32_t argIndex = 0; argIndex < option->maxArgCount; argIndex++)
+		{
+			std::string_view afterArg = remaining;
+			const std::string_view arg = takeToken(afterArg);
+			if (arg.empty() || (argIndex >= option->minArgCount && !isNumber(arg)))
+			{
+				break;
+			}
+			remaining = afterArg;
+		}
+		arguments = trimWhitespace(remaining);
+	}
+	return arguments;
+}
+
+MaterialLibrary::MaterialLibrary(const std::filesystem::path& filepath)
+{
+	InputFileReader file(filepath);
+	if (!file.isOpen())
+	{
+		return;
+	}
+
+	// texture paths are relative to the library
+	const std::filesystem::path libraryDir = filepath.parent_path();
+	std::vector<uint32_t>* currentTextures = nullptr;
+	MaterialNameTable& texturePathTable = getTexturePathTable();
+
+	std::string_view line;
+	while (file.getLine(line))
+	{
+		// statements are often indented below their newmtl
+		const std::string_view keyword = takeToken(line);
+		if (keyword.empty())
+		{
+			continue;
+		}
+
+		if (keyword == "newmtl")
+		{
+			const std::string_view materialName = trimWhitespace(line);
+			currentTextures = materialName.empty() ? nullptr : &materialTextures[std::string(materialName)];
+		}
+		else if (currentTextures != nullptr && isTextureStatement(keyword))
+		{
+			const std::string_view texturePathArg = getTexturePath(line);
+			if (texturePathArg.empty())
+			{
+				continue;
+			}
+			const std::filesystem::path texturePath = (libraryDir / texturePathArg).lexically_normal();
+			const uint32_t textureId = texturePathTable.intern(texturePath.generic_string());
+			if (std::find(currentTextures->begin(), currentTextures->end(), textureId) == currentTextures->end())
+			{
+				currentTextures->push_back(textureId);
+			}
+		}
+	}
+	bLoaded = !file.hasFailed();
+};
+
+bool MaterialLibrary::isTextureStatement(std::string_view keyword)
+{
+	return keyword.starts_with("map_")
+		|| keyword == "bump"
+		|| keyword == "disp"
+		|| keyword == "decal"
+		|| keyword == "refl"
+		|| keyword == "norm";
+};
+
+bool MaterialLibrary::isLoaded() const
+{
+	return bLoaded;
+};
+
+size_t MaterialLibrary::getMaterialCount() const
+{
+	return materialTextures.size();
+};
+
+const std::vector<uint32_t>* MaterialLibrary::findTextures(std::string_view materialName) const
+{
+	auto it = materialTextures.find(materialName);
+	return it != materialTextures.end() ? &it->second : nullptr;
+};
+
+// --------------------------------
+std::shared_ptr<const MaterialLibrary> MaterialLibraryCache::get(const std::filesystem::path& filepath)
+{
+	// "a/../lib.mtl" & "./lib.mtl" from different obj files are the same library
+	std::error_code errorCode;
+	std::filesystem::path libraryPath = std::filesystem::weakly_canonical(filepath, errorCode);
+	if (errorCode)
+	{
+		libraryPath = filepath.lexically_normal();
+	}
+
+	std::promise<std::shared_ptr<const MaterialLibrary>> loadPromise;
+	std::shared_future<std::shared_ptr<const MaterialLibrary>> library;
+	bool bShouldLoad = false;
+	{
+		std::lock_guard lock(librariesMutex);
+		auto [it, bIsNew] = libraries.try_emplace(libraryPath);
+		if (bIsNew)
+		{
+			it->second = loadPromise.get_future().share();
+			bShouldLoad = true;
+		}
+		library = it->second;
+	}
+
+	// load outside the lock so different libraries load concurrently
+	if (bShouldLoad)
+	{
+		loadPromise.set_value(std::make_shared<const MaterialLibrary>(libraryPath));
+	}
+	return library.get();
+};
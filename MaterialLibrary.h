@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// materials of a .mtl file & the texture maps they reference
+class MaterialLibrary
+{
+	// allows looking up names by string_view without copying them
+	struct NameHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); };
+	};
+
+	// getTexturePathTable() ids per material name
+	std::unordered_map<std::string, std::vector<uint32_t>, NameHash, std::equal_to<>> materialTextures;
+	bool bLoaded = false;
+
+	// map_Kd, map_bump, bump, disp, decal, refl, norm, ...
+	static bool isTextureStatement(std::string_view keyword);
+
+public:
+	// reads the library, isLoaded() is false if it can't be read
+	MaterialLibrary(const std::filesystem::path& filepath);
+
+	bool isLoaded() const;
+	size_t getMaterialCount() const;
+
+	// null if the library doesn't define the material
+	const std::vector<uint32_t>* findTextures(std::string_view materialName) const;
+};
+
+// loads each library once per run & shares it between all files & threads referencing it
+class MaterialLibraryCache
+{
+	std::map<std::filesystem::path, std::shared_future<std::shared_ptr<const MaterialLibrary>>> libraries;
+	std::mutex librariesMutex;
+
+public:
+	// keyed by canonical path, so each library is loaded once however obj files refer to it
+	// blocks while another thread is loading the same library
+	std::shared_ptr<const MaterialLibrary> get(const std::filesystem::path& filepath);
+};
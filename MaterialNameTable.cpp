@@ -0,0 +1,167 @@
+#include "MaterialNameTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+static MaterialNameTable materialNameTable;
+static MaterialNameTable texturePathTable;
+
+MaterialNameTable& getMaterialNameTable()
+{
+	return materialNameTable;
+}
+
+MaterialNameTable& getTexturePathTable()
+{
+	return texturePathTable;
+}
+
+uint64_t MaterialNameTable::hashName(std::string_view name)
+{
+	// FNV-1a, names are short
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (const char c : name)
+	{
+		hash = (hash ^ uint8_t(c)) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+uint32_t MaterialNameTable::find(std::string_view name, uint64_t hash) const
+{
+	if (slots.empty())
+	{
+		return invalidId;
+	}
+
+	const size_t slotMask = slots.size() - 1;
+	for (size_t slotIndex = hash & slotMask; slots[slotIndex] != 0; slotIndex = (slotIndex + 1) & slotMask)
+	{
+		const uint32_t id = slots[slotIndex] - 1;
+		if (nameHashes[id] == hash && names[id] == name)
+		{
+			return id;
+		}
+	}
+	return invalidId;
+}
+
+std::string_view MaterialNameTable::copyToArena(std::string_view name)
+{
+	if (name.size() > arenaRemaining)
+	{
+		if (name.size() > arenaBlockSize / 4)
+		{
+			// own block, so the current one keeps being filled
+			char* copy = arenaBlocks.emplace_back(std::make_unique<char[]>(name.size())).get();
+			std::memcpy(copy, name.data(), name.size());
+			return std::string_view(copy, name.size());
+		}
+		arenaCursor = arenaBlocks.emplace_back(std::make_unique<char[]>(arenaBlockSize)).get();
+		arenaRemaining = arenaBlockSize;
+	}
+	char* copy = arenaCursor;
+	std::memcpy(copy, name.data(), name.size());
+	arenaCursor += name.size();
+	arenaRemaining -= name.size();
+	return std::string_view(copy, name.size());
+}
+
+void MaterialNameTable::growSlots()
+{
+	std::vector<uint32_t> newSlots(slots.empty() ? initialSlotCount : slots.size() * 2, 0);
+	const size_t slotMask = newSlots.size() - 1;
+	for (uint32_t id = 0; id < names.size(); id++)
+	{
+		size_t slotIndex = nameHashes[id] & slotMask;
+		while (newSlots[slotIndex] != 0)
+		{
+			slotIndex = (slotIndex + 1) & slotMask;
+		}
+		newSlots[slotIndex] = id + 1;
+	}
+	slots = std::move(newSlots);
+}
+
+uint32_t MaterialNameTable::intern(std::string_view name)
+{
+	const uint64_t hash = hashName(name);
+	{
+		std::shared_lock lock(tableMutex);
+		const uint32_t id = find(name, hash);
+		if (id != invalidId)
+		{
+			return id;
+		}
+	}
+
+	std::unique_lock lock(tableMutex);
+	// another thread may have added it in between
+	uint32_t id = find(name, hash);
+	if (id != invalidId)
+	{
+		return id;
+	}
+
+	if ((names.size() + 1) * 2 > slots.size())
+	{
+		growSlots();
+	}
+	id = uint32_t(names.size());
+	names.push_back(copyToArena(name));
+	nameHashes.push_back(hash);
+	usageCounts.push_back(0);
+
+	const size_t slotMask = slots.size() - 1;
+	size_t slotIndex = hash & slotMask;
+	while (slots[slotIndex] != 0)
+	{
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+	slots[slotIndex] = id + 1;
+	return id;
+}
+
+uint32_t MaterialNameTable::findId(std::string_view name) const
+{
+	std::shared_lock lock(tableMutex);
+	return find(name, hashName(name));
+}
+
+std::string_view MaterialNameTable::getName(uint32_t id) const
+{
+	std::shared_lock lock(tableMutex);
+	return id < names.size() ? names[id] : std::string_view();
+}
+
+size_t MaterialNameTable::size() const
+{
+	std::shared_lock lock(tableMutex);
+	return names.size();
+}
+
+void MaterialNameTable::addUsage(const std::vector<uint32_t>& materialIds)
+{
+	std::unique_lock lock(tableMutex);
+	for (const uint32_t id : materialIds)
+	{
+		usageCounts[id]++;
+	}
+}
+
+std::vector<std::pair<std::string_view, uint64_t>> MaterialNameTable::getUsageCounts() const
+{
+	std::vector<std::pair<std::string_view, uint64_t>> nameUsageCounts;
+	{
+		std::shared_lock lock(tableMutex);
+		nameUsageCounts.reserve(names.size());
+		for (uint32_t id = 0; id < names.size(); id++)
+		{
+			nameUsageCounts.emplace_back(names[id], usageCounts[id]);
+		}
+	}
+	// ids depend on the order files were parsed in, so ties are ordered by name
+	std::sort(nameUsageCounts.begin(), nameUsageCounts.end(), [](const auto& a, const auto& b) { return a.second != b.second ? a.second > b.second : a.first < b.first; });
+	return nameUsageCounts;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// run wide string interner for material names & texture paths, maps each distinct name to a dense id
+// names are copied into arena blocks & never freed, so returned views stay valid for the run
+// open addressing index with linear probing, full names are compared so distinct names never share an id
+class MaterialNameTable
+{
+	std::vector<std::unique_ptr<char[]>> arenaBlocks;
+	char* arenaCursor = nullptr;
+	size_t arenaRemaining = 0;
+	static constexpr size_t arenaBlockSize = 64 << 10; // 64 KiB
+
+	// per id
+	std::vector<std::string_view> names;
+	std::vector<uint64_t> nameHashes;
+	std::vector<uint64_t> usageCounts;
+	// id + 1, 0 = empty, 1/2 load
+	std::vector<uint32_t> slots;
+	static constexpr size_t initialSlotCount = 256;
+
+	// parsing threads of all files intern concurrently, new names are rare compared to lookups
+	mutable std::shared_mutex tableMutex;
+
+	static uint64_t hashName(std::string_view name);
+	// UINT32_MAX if not interned, caller holds the lock
+	uint32_t find(std::string_view name, uint64_t hash) const;
+	std::string_view copyToArena(std::string_view name);
+	void growSlots();
+
+public:
+	static constexpr uint32_t invalidId = UINT32_MAX;
+
+	// id of name, added if new
+	uint32_t intern(std::string_view name);
+	// invalidId if never interned
+	uint32_t findId(std::string_view name) const;
+	std::string_view getName(uint32_t id) const;
+	size_t size() const;
+
+	// count a reported collection using each of materialIds
+	void addUsage(const std::vector<uint32_t>& materialIds);
+	// name & number of reported collections using it, most used first
+	std::vector<std::pair<std::string_view, uint64_t>> getUsageCounts() const;
+};
+
+// table shared by all collections of the run
+MaterialNameTable& getMaterialNameTable();
+// texture paths of all loaded libraries, normalized so each texture has one id however libraries refer to it
+MaterialNameTable& getTexturePathTable();
@@ -1,5 +1,95 @@
 #include "ObjAnalyzer.h"
 
+void outputFileReports(FileProcessor& processor, ResultOutputterBase* outputFormatter, RunStats* runStats)
+{
+	FileStats& stats = processor.getStats();
+	const auto startTime = std::chrono::steady_clock::now();
+
+	if (outputFormatter)
+	{
+		outputFormatter->setPhaseTimings(runStats ? &stats.phases : nullptr);
+		// rows are read into one collection, which keeps its buffers from row to row
+		PrimDataCollection asset{ std::string_view() };
+		for (size_t row = 0; row < processor.resultStore.size(); row++)
+		{
+			processor.resultStore.load(row, asset);
+			outputFormatter->outputReports(asset);
+			if (processor.settings.bReportMaterialUsage)
+			{
+				getMaterialNameTable().addUsage(asset.getMaterialIds());
+			}
+		}
+		outputFormatter->setPhaseTimings(nullptr);
+	}
+
+	if (runStats)
+	{
+		stats.totalTime += std::chrono::steady_clock::now() - startTime;
+		runStats->addFile(FileStats(stats));
+	}
+};
+
+void outputMaterialUsage(LogManager& loggingManager)
+{
+	const std::vector<std::pair<std::string_view, uint64_t>> usageCounts = getMaterialNameTable().getUsageCounts();
+	std::string usageReport = "------------------------------\nMaterial usage:\n------------------------------\n";
+	for (const auto& [materialName, usageCount] : usageCounts)
+	{
+		std::format_to(std::back_inserter(usageReport), "{:>10L}  {}\n", usageCount, materialName);
+	}
+	usageReport += "------------------------------\n";
+	loggingManager.log({ logVerbosity::None, usageReport });
+};
+
+void outputRunStats(const RunStats& runStats, const std::filesystem::path& statsFilePath, LogManager& loggingManager)
+{
+	const std::string statsJson = runStats.toJson();
+	if (statsFilePath.empty())
+	{
+		loggingManager.log({ logVerbosity::None, statsJson });
+		return;
+	}
+
+	loggingManager.logMsgIo(LogPresetIo::StatsPathWrite_log, statsFilePath);
+	std::ofstream statsFile(statsFilePath, std::ios::trunc);
+	statsFile << statsJson;
+	statsFile.close();
+	if (!statsFile)
+	{
+		loggingManager.logMsgIo(LogPresetIo::StatsFileWriteFail_warn, statsFilePath);
+	}
+};
+
+void processFileCached(FileProcessor& processor, ResultCache* resultCache, LogManager& loggingManager)
+{
+	if (resultCache == nullptr)
+	{
+		processor.processFile();
+		return;
+	}
+
+	ResultCache::EntryKey cacheKey;
+	const bool hasCacheKey = resultCache->makeKey(processor.getFilepath(), processor.settings, cacheKey);
+	if (hasCacheKey && resultCache->load(cacheKey, processor.resultStore))
+	{
+		loggingManager.logMsgIo(LogPresetIo::CacheHit_log, processor.getFilepath());
+		return;
+	}
+
+	processor.processFile();
+
+	// partial or already streamed results can't be stored
+	if (hasCacheKey
+		&& !processor.isStreaming()
+		&& !processor.hasStoppedEarly()
+		&& !processor.hasReadFailed()
+		&& !resultCache->store(cacheKey, processor.resultStore)
+		)
+	{
+		loggingManager.logMsgIo(LogPresetIo::CacheWriteFail_warn, processor.getFilepath());
+	}
+};
+
 int main(int argc, char* argv[])
 {
 	// create the logging manager first to allow logging of arg issues
@@ -12,10 +102,12 @@ int main(int argc, char* argv[])
 		return 0;
 	}
 	loggingManager.enableLoggingToFile(argParser.getLogPath());
+	loggingManager.enableAsync();
 
 	try
 	{
 		const ProcessingSettings settings = argParser.asSettings();
+		loggingManager.setProcessingWarningLimit(settings.processingWarningLimit);
 
 		std::unique_ptr<ResultOutputterBase> outputFormatter;
 		switch (settings.mode)
@@ -24,20 +116,144 @@ int main(int argc, char* argv[])
 		case ProcessingMode::Validate: outputFormatter = std::make_unique<ResultOutputterValidate>(settings, loggingManager); break;
 		case ProcessingMode::Budget:   outputFormatter = std::make_unique<ResultOutputterBudget>(settings, loggingManager); break;
 		}
+		outputFormatter->writeCsvHeader();
+
+		std::unique_ptr<RunStats> runStats;
+		if (settings.bCollectStats)
+		{
+			runStats = std::make_unique<RunStats>();
+		}
+
+		std::unique_ptr<ResultCache> resultCache;
+		if (!settings.cacheDirPath.empty())
+		{
+			resultCache = std::make_unique<ResultCache>(settings.cacheDirPath, settings.bCacheHashContent);
+		}
+
+		// shared by all files, so libraries referenced by many files are only read once
+		std::unique_ptr<MaterialLibraryCache> materialLibraryCache;
+		if (settings.bResolveMaterials)
+		{
+			materialLibraryCache = std::make_unique<MaterialLibraryCache>();
+		}
+
+		// shared by all files & their chunks, so -uniquemem bounds the whole run
+		UniqueVertexMemoryBudget uniqueVertexMemoryBudget(settings.uniqueVertMemoryCap);
+
+		// shared by all files, only large files are split across it
+		std::unique_ptr<WorkerPool> chunkWorkerPool;
+		if (settings.parseThreadCount > 1)
+		{
+			chunkWorkerPool = std::make_unique<WorkerPool>(settings.parseThreadCount);
+		}
 
-		for (const std::filesystem::path& filepath : settings.inputFilePaths)
+		if (settings.fileJobCount > 1)
 		{
-			FileProcessor processor(filepath, settings, loggingManager);
-			processor.processFile();
+			// declared before the pool so queued jobs outlive the workers using them
+			std::deque<FileJob> queuedFiles;
+			WorkerPool fileWorkerPool(settings.fileJobCount);
+
+			// bound number of processed files held in memory while waiting for their turn to be output
+			const size_t maxQueuedFiles = size_t(settings.fileJobCount) * 2;
+			// arenas of output files, handed to the next queued files
+			std::vector<std::unique_ptr<FileArena>> idleArenas;
+
+			auto outputOldestFile = [&]()
+				{
+					FileJob& job = queuedFiles.front();
+					job.result.wait();
+					// log before rethrowing any error so the cause is visible
+					loggingManager.logCaptured(job.loggingManager->takeCapturedLog());
+					job.result.get();
+
+					outputFileReports(*job.processor, outputFormatter.get(), runStats.get());
+					job.processor.reset();
+					job.arena->release();
+					idleArenas.push_back(std::move(job.arena));
+					queuedFiles.pop_front();
+				};
 
-			if (outputFormatter)
+			for (const std::filesystem::path& filepath : settings.inputFilePaths)
 			{
-				for (const PrimDataCollection& asset : processor.PrimDataCollections)
+				if (queuedFiles.size() >= maxQueuedFiles)
+				{
+					outputOldestFile();
+				}
+
+				FileJob& job = queuedFiles.emplace_back();
+				job.loggingManager = std::make_unique<LogManager>();
+				job.loggingManager->enableCapture();
+				job.loggingManager->setProcessingWarningLimit(settings.processingWarningLimit);
+				if (idleArenas.empty())
 				{
-					outputFormatter->outputReports(asset);
+					job.arena = std::make_unique<FileArena>();
 				}
+				else
+				{
+					job.arena = std::move(idleArenas.back());
+					idleArenas.pop_back();
+				}
+				job.processor = std::make_unique<FileProcessor>(filepath, settings, *job.loggingManager, chunkWorkerPool.get(), job.arena.get(), &uniqueVertexMemoryBudget);
+				job.processor->setMaterialLibraryCache(materialLibraryCache.get());
+				job.result = fileWorkerPool.submit([processor = job.processor.get(), jobLoggingManager = job.loggingManager.get(), cache = resultCache.get()]()
+					{
+						processFileCached(*processor, cache, *jobLoggingManager);
+					});
+			}
+
+			while (!queuedFiles.empty())
+			{
+				outputOldestFile();
 			}
 		}
+		else
+		{
+			// transient state of each file, released once the file is output
+			FileArena fileArena;
+			for (const std::filesystem::path& filepath : settings.inputFilePaths)
+			{
+				// the previous file's processor is destroyed at the end of its iteration
+				fileArena.release();
+				FileProcessor processor(filepath, settings, loggingManager, chunkWorkerPool.get(), &fileArena, &uniqueVertexMemoryBudget);
+				processor.setMaterialLibraryCache(materialLibraryCache.get());
+				if (settings.bStreamReports && outputFormatter)
+				{
+					// streamed reports are output while processing
+					outputFormatter->setPhaseTimings(runStats ? &processor.getStats().phases : nullptr);
+					processor.setCollectionClosedCallback([&outputFormatter, &settings](const PrimDataCollection& asset)
+						{
+							outputFormatter->outputReports(asset);
+							if (settings.bReportMaterialUsage)
+							{
+								getMaterialNameTable().addUsage(asset.getMaterialIds());
+							}
+						});
+				}
+				processFileCached(processor, resultCache.get(), loggingManager);
+
+				outputFileReports(processor, outputFormatter.get(), runStats.get());
+			}
+		}
+
+		if (outputFormatter)
+		{
+			outputFormatter->flushCsv();
+		}
+
+		if (settings.bReportMaterialUsage)
+		{
+			outputMaterialUsage(loggingManager);
+		}
+
+		if (resultCache)
+		{
+			loggingManager.logMsgIo(LogPresetIo::CacheStats_log, resultCache->getHitCount(), resultCache->getMissCount());
+		}
+
+		if (runStats)
+		{
+			outputRunStats(*runStats, settings.statsFilePath, loggingManager);
+		}
 		return 0;
 	}
 	catch (LoggedErrorException e)
@@ -1,8 +1,36 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <memory>
 
+#include "FileArena.h"
 #include "LogManager.h"
+#include "MaterialNameTable.h"
 #include "OutputHandlers.h"
-#include "Processors.h"
\ No newline at end of file
+#include "ProcessingStats.h"
+#include "Processors.h"
+#include "ResultCache.h"
+#include "WorkerPool.h"
+
+// file processed on a file worker, its log output is held back until its reports are output in input order
+struct FileJob
+{
+	std::unique_ptr<LogManager> loggingManager;
+	// recycled for a later file once output, declared before processor so it outlives it
+	std::unique_ptr<FileArena> arena;
+	std::unique_ptr<FileProcessor> processor;
+	std::future<void> result;
+};
+
+// load results from cache if available, else process & store them
+void processFileCached(FileProcessor& processor, ResultCache* resultCache, LogManager& loggingManager);
+// output reports of processed file & add its stats to runStats if collecting them
+void outputFileReports(FileProcessor& processor, ResultOutputterBase* outputFormatter, RunStats* runStats);
+// list materials by number of reported collections using them
+void outputMaterialUsage(LogManager& loggingManager);
+// write stats json to statsFilePath, or to the log if empty
+void outputRunStats(const RunStats& runStats, const std::filesystem::path& statsFilePath, LogManager& loggingManager);
@@ -1,6 +1,61 @@
 #include "OutputHandlers.h"
 
-ResultOutputterBase::ResultOutputterBase(const ProcessingSettings& settings, LogManager& loggingManager) : settings(settings), loggingManager(loggingManager) {};
+ResultOutputterBase::ResultOutputterBase(const ProcessingSettings& settings, LogManager& loggingManager) : settings(settings), loggingManager(loggingManager)
+{
+	if (!settings.csvFilePath.empty())
+	{
+		csvWriter = std::make_unique<CsvFileWriter>(settings.csvFilePath);
+		if (csvWriter->hasFailed())
+		{
+			loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, settings.csvFilePath);
+		}
+		loggingManager.logMsgIo(LogPresetIo::CsvPathWrite_log, settings.csvFilePath);
+	}
+};
+
+void ResultOutputterBase::writeCsvHeader()
+{
+	if (!csvWriter || bCsvHeaderWritten)
+	{
+		return;
+	}
+	bCsvHeaderWritten = true;
+	outputCsvHeader(*csvWriter);
+	if (csvWriter->hasHeaderMismatch())
+	{
+		loggingManager.logMsgIo(LogPresetIo::CsvHeaderMismatch_err, settings.csvFilePath);
+	}
+};
+
+void ResultOutputterBase::outputCsvRow(const PrimDataCollection& asset)
+{
+	writeCsvHeader();
+	outputToCsv(asset, *csvWriter);
+
+	// set by block writes once the buffer is full
+	if (csvWriter->hasFailed())
+	{
+		loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, settings.csvFilePath);
+	}
+};
+
+std::chrono::nanoseconds* ResultOutputterBase::getPhaseTimingTarget(std::chrono::nanoseconds PhaseTimings::* phase) const
+{
+	return phaseTimings ? &(phaseTimings->*phase) : nullptr;
+};
+
+void ResultOutputterBase::setPhaseTimings(PhaseTimings* timings)
+{
+	phaseTimings = timings;
+};
+
+void ResultOutputterBase::flushCsv()
+{
+	if (csvWriter && !csvWriter->flush())
+	{
+		loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, settings.csvFilePath);
+	}
+};
 
 // --------------------------------
 ResultOutputterOverview::ResultOutputterOverview(const ProcessingSettings& settings, LogManager& loggingManager) : ResultOutputterBase(settings, loggingManager) {};
@@ -41,18 +96,99 @@ const std::string ResultOutputterOverview::generateTxtFormattedReport(const Prim
 		asset.getMaterialCount(), // 11
 		asset.hasVertNormals,     // 12
 		asset.hasVertColor,       // 13
-		asset.hasUvs              // 14
+		asset.hasUvs,             // 14
+		generateTxtFormattedAnalyses(asset), // 15
+		generateTxtFormattedUniqueVerts(asset), // 16
+		asset.faceTriEquivalentCount        // 17
 	);
 };
 
+const std::string ResultOutputterOverview::generateTxtFormattedUniqueVerts(const PrimDataCollection& asset) const
+{
+	if (!settings.bCountUniqueVerts)
+	{
+		return {};
+	}
+	return std::format("  Unique vertices:    {:L}{}\n", asset.uniqueVertCount, asset.uniqueVertCountIsUpperBound ? " (upper bound, memory cap reached)" : "");
+};
+
+const std::string ResultOutputterOverview::generateTxtFormattedAnalyses(const PrimDataCollection& asset) const
+{
+	std::string textReport;
+	if (settings.bComputeBounds)
+	{
+		if (asset.hasBounds())
+		{
+			const std::array<float, 3> extent = asset.getExtent();
+			const std::array<double, 3> centroid = asset.getCentroid();
+			std::format_to(std::back_inserter(textReport),
+				"  Bounds min:         ({:g}, {:g}, {:g})\n"
+				"  Bounds max:         ({:g}, {:g}, {:g})\n"
+				"  Extent:             ({:g}, {:g}, {:g})\n"
+				"  Centroid:           ({:g}, {:g}, {:g})\n",
+				asset.boundsMin[0], asset.boundsMin[1], asset.boundsMin[2],
+				asset.boundsMax[0], asset.boundsMax[1], asset.boundsMax[2],
+				extent[0], extent[1], extent[2],
+				centroid[0], centroid[1], centroid[2]
+			);
+		}
+		else
+		{
+			textReport += "  Bounds:             N/A\n";
+		}
+	}
+	if (settings.bCheckFaceIndices)
+	{
+		std::format_to(std::back_inserter(textReport), "  Invalid indices:    {:L}\n", asset.invalidFaceIndexCount);
+	}
+	if (settings.bAnalyzeTopology)
+	{
+		std::format_to(std::back_inserter(textReport),
+			"  Degenerate faces:   {:L}\n"
+			"  Boundary edges:     {:L}\n"
+			"  Non-manifold edges: {:L}\n"
+			"  Isolated vertices:  {:L}\n",
+			asset.degenerateFaceCount,
+			asset.boundaryEdgeCount,
+			asset.nonManifoldEdgeCount,
+			asset.isolatedVertCount
+		);
+	}
+	if (settings.bResolveMaterials)
+	{
+		std::format_to(std::back_inserter(textReport),
+			"  Texture maps:       {:L}\n"
+			"  Undefined materials: {:L}",
+			asset.getTextureCount(),
+			asset.getUndefinedMaterialCount()
+		);
+		// names are interned, so the undefined ones can be listed
+		const char* separator = " (";
+		for (const std::string_view materialName : asset.getUndefinedMaterialNames())
+		{
+			textReport += separator;
+			textReport += materialName;
+			separator = ", ";
+		}
+		textReport += asset.getUndefinedMaterialCount() != 0 ? ")\n" : "\n";
+	}
+	return textReport;
+};
+
 void ResultOutputterOverview::outputReports(const PrimDataCollection& asset)
 {
 	// output based no settings
-	const auto& txtReport = generateTxtFormattedReport(asset);
-	if (!settings.csvFilePath.empty())
+	std::string txtReport;
 	{
-		outputToCsv(asset, settings.csvFilePath);
+		ScopedPhaseTimer formattingTimer(getPhaseTimingTarget(&PhaseTimings::reportFormatting));
+		txtReport = generateTxtFormattedReport(asset);
 	}
+	if (csvWriter)
+	{
+		ScopedPhaseTimer csvTimer(getPhaseTimingTarget(&PhaseTimings::csvWriting));
+		outputCsvRow(asset);
+	}
+	ScopedPhaseTimer loggingTimer(getPhaseTimingTarget(&PhaseTimings::logging));
 	outputToLog(txtReport);
 };
 
@@ -66,30 +202,113 @@ void ResultOutputterOverview::outputToLog(const PrimDataCollection& asset)
 	loggingManager.log(std::pair(logVerbosity::None, generateTxtFormattedReport(asset)));
 };
 
-void ResultOutputterOverview::outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep)
+void ResultOutputterOverview::outputCsvHeader(CsvFileWriter& writer) const
 {
-	std::ofstream csvFile(filepath, std::ios::app);
-	// TODO: add header if not present
-	csvFile << asset.name << sep
-		<< asset.vertCount << sep
-		<< asset.faceTotalCount << sep
-		<< asset.faceTriCount << sep
-		<< asset.faceQuadCount << sep
-		<< asset.faceNgonCount << sep
-		<< asset.pointCount << sep
-		<< asset.lineCount << sep
-		<< asset.getMaterialCount() << sep
-		<< asset.subgroupCount << sep
-		<< bool(asset.hasVertNormals) << sep
-		<< bool(asset.hasVertColor) << sep
-		<< bool(asset.hasUvs) << std::endl
-		;
-	csvFile.close();
+	// grouping dependent: subgroup count
+	std::string_view groupCategory;
+	switch (settings.grouping)
+	{
+	case DataCollectionGrouping::File:        groupCategory = "Objects"; break;
+	case DataCollectionGrouping::Object:      groupCategory = "Groups"; break;
+	case DataCollectionGrouping::Vertexgroup: groupCategory = "N/A"; break;
+	};
+
+	for (std::string_view columnName : { "Name", "Vertices", "Faces", "Tris", "Quads", "Ngons", "Loose points", "Loose edges", "Materials" })
+	{
+		writer.addField(columnName);
+	}
+	writer.addField(groupCategory);
+	for (std::string_view columnName : { "Has vertex normals", "Has vertex color", "Has UVs" })
+	{
+		writer.addField(columnName);
+	}
+	// optional columns are always written & left empty when disabled,
+	// so a csv appended to by runs with different flags keeps a single header
+	for (std::string_view columnName : {
+		"Min X", "Min Y", "Min Z", "Max X", "Max Y", "Max Z",
+		"Extent X", "Extent Y", "Extent Z", "Centroid X", "Centroid Y", "Centroid Z" })
+	{
+		writer.addField(columnName);
+	}
+	writer.addField("Invalid face indices");
+	writer.addField("Unique vertices");
+	for (std::string_view columnName : { "Degenerate faces", "Boundary edges", "Non-manifold edges", "Isolated vertices" })
+	{
+		writer.addField(columnName);
+	}
+	writer.addField("Tri equivalents");
+	writer.addField("Texture maps");
+	writer.addField("Undefined materials");
+	writer.endRow();
+};
 
-	if (!csvFile)
+void ResultOutputterOverview::outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const
+{
+	writer.addField(asset.name);
+	writer.addField(asset.vertCount);
+	writer.addField(asset.faceTotalCount);
+	writer.addField(asset.faceTriCount);
+	writer.addField(asset.faceQuadCount);
+	writer.addField(asset.faceNgonCount);
+	writer.addField(asset.pointCount);
+	writer.addField(asset.lineCount);
+	writer.addField(asset.getMaterialCount());
+	writer.addField(asset.subgroupCount);
+	writer.addField(bool(asset.hasVertNormals));
+	writer.addField(bool(asset.hasVertColor));
+	writer.addField(bool(asset.hasUvs));
+	if (settings.bComputeBounds && asset.hasBounds())
 	{
-		loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, filepath);
+		const std::array<float, 3> extent = asset.getExtent();
+		const std::array<double, 3> centroid = asset.getCentroid();
+		for (const float value : asset.boundsMin) { writer.addField(double(value)); }
+		for (const float value : asset.boundsMax) { writer.addField(double(value)); }
+		for (const float value : extent)          { writer.addField(double(value)); }
+		for (const double value : centroid)       { writer.addField(value); }
 	}
+	else
+	{
+		for (int i = 0; i < 12; i++) { writer.addEmptyField(); }
+	}
+	if (settings.bCheckFaceIndices)
+	{
+		writer.addField(asset.invalidFaceIndexCount);
+	}
+	else
+	{
+		writer.addEmptyField();
+	}
+	if (settings.bCountUniqueVerts)
+	{
+		writer.addField(asset.uniqueVertCount);
+	}
+	else
+	{
+		writer.addEmptyField();
+	}
+	if (settings.bAnalyzeTopology)
+	{
+		writer.addField(asset.degenerateFaceCount);
+		writer.addField(asset.boundaryEdgeCount);
+		writer.addField(asset.nonManifoldEdgeCount);
+		writer.addField(asset.isolatedVertCount);
+	}
+	else
+	{
+		for (int i = 0; i < 4; i++) { writer.addEmptyField(); }
+	}
+	writer.addField(asset.faceTriEquivalentCount);
+	if (settings.bResolveMaterials)
+	{
+		writer.addField(asset.getTextureCount());
+		writer.addField(asset.getUndefinedMaterialCount());
+	}
+	else
+	{
+		writer.addEmptyField();
+		writer.addEmptyField();
+	}
+	writer.endRow();
 };
 
 // --------------------------------
@@ -108,6 +327,19 @@ const std::string ResultOutputterValidate::makeLineFromBoolElem(const Validation
 	return {};
 };
 
+const std::string ResultOutputterValidate::makeLineFromFloatElem(const ValidationFloatElem& validationElem, const float statValue, const std::string& statName) const
+{
+	if (validationElem.shouldCheck)
+	{
+		return format("{:<20} (<={:g})  {}\n",
+			statName,
+			validationElem.maxValue,
+			statValue <= validationElem.maxValue ? "PASS" : "FAIL"
+		);
+	}
+	return {};
+};
+
 const std::string ResultOutputterValidate::generateTxtFormattedReport(const PrimDataCollection& asset) const
 {
 	// grouping dependent: name & group count
@@ -140,6 +372,13 @@ const std::string ResultOutputterValidate::generateTxtFormattedReport(const Prim
 	textReport += makeLineFromBoolElem(settings.validations.containsVertexColor, asset.hasVertColor, "Has vertex colors:");
 	textReport += makeLineFromBoolElem(settings.validations.containsUvs, asset.hasUvs, "Has UVs:");
 	textReport += makeLineFromBoolElem(settings.validations.MissingName, asset.name.empty(), "Missing Name:");
+	textReport += makeLineFromBoolElem(settings.validations.containsInvalidFaceIndices, asset.invalidFaceIndexCount, "Has invalid indices:");
+	textReport += makeLineFromBoolElem(settings.validations.containsDegenerateFaces, asset.degenerateFaceCount, "Degenerate faces:");
+	textReport += makeLineFromBoolElem(settings.validations.containsBoundaryEdges, asset.boundaryEdgeCount, "Boundary edges:");
+	textReport += makeLineFromBoolElem(settings.validations.containsNonManifoldEdges, asset.nonManifoldEdgeCount, "Non-manifold edges:");
+	textReport += makeLineFromBoolElem(settings.validations.containsIsolatedVerts, asset.isolatedVertCount, "Isolated vertices:");
+	textReport += makeLineFromBoolElem(settings.validations.containsUndefinedMaterials, asset.getUndefinedMaterialCount(), "Undefined materials:");
+	textReport += makeLineFromFloatElem(settings.validations.maxExtent, asset.getMaxExtent(), "Max extent:");
 
 	if (settings.validations.namePrefix.shouldCheck)
 	{
@@ -166,32 +405,50 @@ const std::string ResultOutputterValidate::generateTxtFormattedReport(const Prim
 	return textReport;
 };
 
-inline const std::string ResultOutputterValidate::makeCsvValueFromValidationElem(const ValidationBoolElem& validationElem, const bool statValue) const
+inline void ResultOutputterValidate::addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationBoolElem& validationElem, const bool statValue) const
 {
 	if (validationElem.shouldCheck)
 	{
-		return statValue ? "true" : "false";
+		writer.addField(statValue ? "true" : "false");
+		return;
 	}
-	return {};
+	writer.addEmptyField();
 };
 
-inline const std::string ResultOutputterValidate::makeCsvValueFromValidationElem(const ValidationStringElem& validationElem, const bool isValid) const
+inline void ResultOutputterValidate::addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationStringElem& validationElem, const bool isValid) const
 {
 	if (validationElem.shouldCheck)
 	{
-		return isValid ? "true" : "false";
+		writer.addField(isValid ? "true" : "false");
+		return;
 	}
-	return {};
+	writer.addEmptyField();
+};
+
+inline void ResultOutputterValidate::addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationFloatElem& validationElem, const float statValue) const
+{
+	if (validationElem.shouldCheck)
+	{
+		writer.addField(statValue <= validationElem.maxValue ? "true" : "false");
+		return;
+	}
+	writer.addEmptyField();
 };
 
 void ResultOutputterValidate::outputReports(const PrimDataCollection& asset)
 {
 	// output based no settings
-	const auto& txtReport = generateTxtFormattedReport(asset);
-	if (!settings.csvFilePath.empty())
+	std::string txtReport;
 	{
-		outputToCsv(asset, settings.csvFilePath);
+		ScopedPhaseTimer formattingTimer(getPhaseTimingTarget(&PhaseTimings::reportFormatting));
+		txtReport = generateTxtFormattedReport(asset);
 	}
+	if (csvWriter)
+	{
+		ScopedPhaseTimer csvTimer(getPhaseTimingTarget(&PhaseTimings::csvWriting));
+		outputCsvRow(asset);
+	}
+	ScopedPhaseTimer loggingTimer(getPhaseTimingTarget(&PhaseTimings::logging));
 	outputToLog(txtReport);
 };
 
@@ -211,39 +468,50 @@ void ResultOutputterValidate::outputToLog(const PrimDataCollection& asset)
 	loggingManager.log(std::pair(logVerbosity::None, generateTxtFormattedReport(asset)));
 };
 
-void ResultOutputterValidate::outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep)
+void ResultOutputterValidate::outputCsvHeader(CsvFileWriter& writer) const
 {
-	std::ofstream csvFile(filepath, std::ios::app);
-	// TODO: add header if not present
-
-	csvFile << asset.name << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsVerts, asset.vertCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsFaces, asset.faceTotalCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsTris, asset.faceTriCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsQuads, asset.faceQuadCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsNgons, asset.faceNgonCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsLoosePoints, asset.pointCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsLooseEdges, asset.lineCount) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsMaterials, asset.getMaterialCount()) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsVertexNormals, asset.hasVertNormals) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsVertexColor, asset.hasVertColor) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.containsUvs, asset.hasUvs) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.MissingName, asset.name.empty()) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.namePrefix, asset.name.starts_with(settings.validations.namePrefix.substring)) << sep
-		<< makeCsvValueFromValidationElem(settings.validations.nameSuffix, asset.name.ends_with(settings.validations.nameSuffix.substring)) << std::endl
-		;
-	csvFile.close();
-
-	if (!csvFile)
+	for (std::string_view columnName : {
+		"Name", "Has vertices", "Has faces", "Has tris", "Has quads", "Has ngons", "Has loose points", "Has loose edges",
+		"Has materials", "Has vertex normals", "Has vertex colors", "Has UVs", "Missing name", "Name prefix", "Name suffix", "Max extent", "Has invalid face indices",
+		"Has degenerate faces", "Has boundary edges", "Has non-manifold edges", "Has isolated vertices", "Has undefined materials" })
 	{
-		loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, filepath);
+		writer.addField(columnName);
 	}
+	writer.endRow();
+};
+
+void ResultOutputterValidate::outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const
+{
+	writer.addField(asset.name);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsVerts, asset.vertCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsFaces, asset.faceTotalCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsTris, asset.faceTriCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsQuads, asset.faceQuadCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsNgons, asset.faceNgonCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsLoosePoints, asset.pointCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsLooseEdges, asset.lineCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsMaterials, asset.getMaterialCount());
+	addCsvFieldFromValidationElem(writer, settings.validations.containsVertexNormals, asset.hasVertNormals);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsVertexColor, asset.hasVertColor);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsUvs, asset.hasUvs);
+	addCsvFieldFromValidationElem(writer, settings.validations.MissingName, asset.name.empty());
+	addCsvFieldFromValidationElem(writer, settings.validations.namePrefix, asset.name.starts_with(settings.validations.namePrefix.substring));
+	addCsvFieldFromValidationElem(writer, settings.validations.nameSuffix, asset.name.ends_with(settings.validations.nameSuffix.substring));
+	addCsvFieldFromValidationElem(writer, settings.validations.maxExtent, asset.getMaxExtent());
+	addCsvFieldFromValidationElem(writer, settings.validations.containsInvalidFaceIndices, asset.invalidFaceIndexCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsDegenerateFaces, asset.degenerateFaceCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsBoundaryEdges, asset.boundaryEdgeCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsNonManifoldEdges, asset.nonManifoldEdgeCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsIsolatedVerts, asset.isolatedVertCount);
+	addCsvFieldFromValidationElem(writer, settings.validations.containsUndefinedMaterials, asset.getUndefinedMaterialCount());
+	writer.endRow();
 };
 
 // --------------------------------
 ResultOutputterBudget::ResultOutputterBudget(const ProcessingSettings& settings, LogManager& loggingManager) : ResultOutputterBase(settings, loggingManager) {};
 
-const std::string ResultOutputterBudget::makeLineFromBudgetElem(const BudgetUint32Elem& budgetElem, const uint32_t statValue, const std::string& statName) const
+template<typename BudgetElem, typename StatValue>
+const std::string ResultOutputterBudget::makeLineFromBudgetElem(const BudgetElem& budgetElem, const StatValue statValue, const std::string& statName) const
 {
 	double budgetRatio = double(statValue) / budgetElem.value;
 
@@ -285,15 +553,19 @@ const std::string ResultOutputterBudget::generateTxtFormattedReport(const PrimDa
 	textReport += nameCategory + " name: " + asset.name + '\n';
 	textReport += "------------------------------\n";
 	textReport += makeLineFromBudgetElem(settings.budgets.verts, asset.vertCount, "Vertex count:");
+	textReport += makeLineFromBudgetElem(settings.budgets.uniqueVerts, asset.uniqueVertCount, asset.uniqueVertCountIsUpperBound ? "Unique verts (max):" : "Unique vertices:");
 	textReport += "Face count:\n";
-	textReport += makeLineFromBudgetElem(settings.budgets.faceTotals, asset.faceTriCount, "  Total:");
+	textReport += makeLineFromBudgetElem(settings.budgets.faceTotals, asset.faceTotalCount, "  Total:");
 	textReport += makeLineFromBudgetElem(settings.budgets.faceTris, asset.faceTriCount, "  tri:");
 	textReport += makeLineFromBudgetElem(settings.budgets.faceQuads, asset.faceQuadCount, "  Quad:");
 	textReport += makeLineFromBudgetElem(settings.budgets.faceNgons, asset.faceNgonCount, "  Ngon:");
+	textReport += makeLineFromBudgetElem(settings.budgets.faceTriEquivalents, asset.faceTriEquivalentCount, "  Tri equivalent:");
 	textReport += makeLineFromBudgetElem(settings.budgets.points, asset.pointCount, "Loose point count:");
 	textReport += makeLineFromBudgetElem(settings.budgets.lines, asset.lineCount, "Loose edge count:");
 	textReport += makeLineFromBudgetElem(settings.budgets.materials, uint32_t(asset.getMaterialCount()), "Material count:");
+	textReport += makeLineFromBudgetElem(settings.budgets.textures, uint32_t(asset.getTextureCount()), "Texture maps:");
 	textReport += makeLineFromBudgetElem(settings.budgets.groups, asset.subgroupCount, format("{} count:", groupCategory));
+	textReport += makeLineFromBudgetElem(settings.budgets.maxExtent, asset.getMaxExtent(), "Max extent:");
 
 	if (settings.validations.namePrefix.shouldCheck)
 	{
@@ -320,30 +592,38 @@ const std::string ResultOutputterBudget::generateTxtFormattedReport(const PrimDa
 	return textReport;
 };
 
-const std::string ResultOutputterBudget::makeCsvValueFromBudgetElem(const BudgetUint32Elem& budgetElem, const uint32_t statValue) const
+template<typename BudgetElem, typename StatValue>
+void ResultOutputterBudget::addCsvFieldFromBudgetElem(CsvFileWriter& writer, const BudgetElem& budgetElem, const StatValue statValue) const
 {
 	if (budgetElem.shouldCheck)
 	{
 		if (budgetElem.value != 0)
 		{
-			return std::to_string((double(statValue) / budgetElem.value) * 100); //convert to percentage
+			writer.addField((double(statValue) / budgetElem.value) * 100); //convert to percentage
 		}
 		else
 		{
-			return statValue == 0 ? "PASS" : "FAIL";
+			writer.addField(statValue == 0 ? "PASS" : "FAIL");
 		}
+		return;
 	}
-	return {};
+	writer.addEmptyField();
 };
 
 void ResultOutputterBudget::outputReports(const PrimDataCollection& asset)
 {
 	// output based no settings
-	const auto& txtReport = generateTxtFormattedReport(asset);
-	if (!settings.csvFilePath.empty())
+	std::string txtReport;
 	{
-		outputToCsv(asset, settings.csvFilePath);
+		ScopedPhaseTimer formattingTimer(getPhaseTimingTarget(&PhaseTimings::reportFormatting));
+		txtReport = generateTxtFormattedReport(asset);
 	}
+	if (csvWriter)
+	{
+		ScopedPhaseTimer csvTimer(getPhaseTimingTarget(&PhaseTimings::csvWriting));
+		outputCsvRow(asset);
+	}
+	ScopedPhaseTimer loggingTimer(getPhaseTimingTarget(&PhaseTimings::logging));
 	outputToLog(txtReport);
 };
 
@@ -362,25 +642,44 @@ void ResultOutputterBudget::outputToLog(const PrimDataCollection& asset)
 	loggingManager.log(std::pair(logVerbosity::None, generateTxtFormattedReport(asset)));
 };
 
-void ResultOutputterBudget::outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep)
+void ResultOutputterBudget::outputCsvHeader(CsvFileWriter& writer) const
 {
-	std::ofstream csvFile(filepath, std::ios::app);
-	// TODO: add header if not present
-	csvFile << asset.name << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.verts, asset.vertCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.faceTotals, asset.faceTotalCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.faceTris, asset.faceTriCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.faceQuads, asset.faceQuadCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.faceNgons, asset.faceNgonCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.points, asset.pointCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.lines, asset.lineCount) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.materials, uint32_t(asset.getMaterialCount())) << sep
-		<< makeCsvValueFromBudgetElem(settings.budgets.groups, asset.subgroupCount) << std::endl
-		;
-	csvFile.close();
+	// grouping dependent: subgroup count
+	std::string_view groupCategory;
+	switch (settings.grouping)
+	{
+	case DataCollectionGrouping::File:        groupCategory = "Objects"; break;
+	case DataCollectionGrouping::Object:      groupCategory = "Groups"; break;
+	case DataCollectionGrouping::Vertexgroup: groupCategory = "N/A"; break;
+	};
 
-	if (!csvFile)
+	for (std::string_view columnName : { "Name", "Vertices", "Faces", "Tris", "Quads", "Ngons", "Loose points", "Loose edges", "Materials" })
 	{
-		loggingManager.logMsgIo(LogPresetIo::CsvFileWriteFail_err, filepath);
+		writer.addField(columnName);
 	}
+	writer.addField(groupCategory);
+	writer.addField("Max extent");
+	writer.addField("Unique vertices");
+	writer.addField("Tri equivalents");
+	writer.addField("Texture maps");
+	writer.endRow();
+};
+
+void ResultOutputterBudget::outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const
+{
+	writer.addField(asset.name);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.verts, asset.vertCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.faceTotals, asset.faceTotalCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.faceTris, asset.faceTriCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.faceQuads, asset.faceQuadCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.faceNgons, asset.faceNgonCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.points, asset.pointCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.lines, asset.lineCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.materials, uint32_t(asset.getMaterialCount()));
+	addCsvFieldFromBudgetElem(writer, settings.budgets.groups, asset.subgroupCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.maxExtent, asset.getMaxExtent());
+	addCsvFieldFromBudgetElem(writer, settings.budgets.uniqueVerts, asset.uniqueVertCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.faceTriEquivalents, asset.faceTriEquivalentCount);
+	addCsvFieldFromBudgetElem(writer, settings.budgets.textures, uint32_t(asset.getTextureCount()));
+	writer.endRow();
 };
\ No newline at end of file
@@ -5,22 +5,46 @@
 #include <vector>
 #include <format>
 #include <iostream>
+#include <memory>
 
 #include "Settings.h"
 #include "LogManager.h"
+#include "CsvWriter.h"
+#include "ProcessingStats.h"
 
 class ResultOutputterBase
 {
 protected:
 	const ProcessingSettings& settings;
 	LogManager& loggingManager;
+	// opened once for the whole run, null if no csv output
+	std::unique_ptr<CsvFileWriter> csvWriter;
+	bool bCsvHeaderWritten = false;
+	// output phases are timed into this when set, see setPhaseTimings()
+	PhaseTimings* phaseTimings = nullptr;
+
+	// null if not timing
+	std::chrono::nanoseconds* getPhaseTimingTarget(std::chrono::nanoseconds PhaseTimings::* phase) const;
+
+	virtual void outputCsvHeader(CsvFileWriter& writer) const = 0;
+	// adds header first if not done by writeCsvHeader()
+	void outputCsvRow(const PrimDataCollection& asset);
 public:
 	ResultOutputterBase(const ProcessingSettings& settings, LogManager& loggingManager);
 	virtual ~ResultOutputterBase() = default;
 
 	virtual void outputReports(const PrimDataCollection&) = 0;
 	virtual void outputToLog(const PrimDataCollection&) = 0;
-	virtual void outputToCsv(const PrimDataCollection&, const std::filesystem::path&, const char = ',') = 0;
+	virtual void outputToCsv(const PrimDataCollection&, CsvFileWriter&) const = 0;
+
+	// write the header to a new csv, or check it against the header of the csv being appended to,
+	// call before processing so a mismatch stops the run before any work is done
+	void writeCsvHeader();
+	// write out buffered csv rows, call once all reports are output
+	void flushCsv();
+
+	// time report formatting, csv writing & logging of following reports into timings, null to stop timing
+	void setPhaseTimings(PhaseTimings* timings);
 };
 
 class ResultOutputterOverview : public ResultOutputterBase
@@ -30,11 +54,13 @@ class ResultOutputterOverview : public ResultOutputterBase
 		"{0} name: {1}\n"
 		"------------------------------\n"
 		"  Vertex count:       {4:L}\n"
+		"{16}"
 		"  Face count:\n"
 		"    Total:            {5:L}\n"
 		"    Tri:              {6:L}\n"
 		"    Quad:             {7:L}\n"
 		"    Ngon:             {8:L}\n"
+		"    Tri equivalent:   {17:L}\n"
 		"  Loose point count:  {9:L}\n"
 		"  Loose edge count:   {10:L}\n"
 		"  Material count:     {11:L}\n"
@@ -42,30 +68,41 @@ class ResultOutputterOverview : public ResultOutputterBase
 		"  Has vertex normals: {12}\n"
 		"  Has vertex color:   {13}\n"
 		"  Has UVs             {14}\n"
+		"{15}"
 		"------------------------------\n"
 		;
 
 	const std::string generateTxtFormattedReport(const PrimDataCollection& asset) const;
+	// empty unless settings.bCountUniqueVerts
+	const std::string generateTxtFormattedUniqueVerts(const PrimDataCollection& asset) const;
+	// lines of the optional analyses enabled in settings, empty if none
+	const std::string generateTxtFormattedAnalyses(const PrimDataCollection& asset) const;
 
 	void outputToLog(const std::string& txtReport);
 
+	void outputCsvHeader(CsvFileWriter& writer) const override;
+
 public:
 	ResultOutputterOverview(const ProcessingSettings& settings, LogManager& loggingManager);
 
 	void outputReports(const PrimDataCollection& asset) override;
 
-	void outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep = ',') override;
+	void outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const override;
 	void outputToLog(const PrimDataCollection& asset) override;
 };
 
 class ResultOutputterValidate : public ResultOutputterBase
 {
 	const std::string makeLineFromBoolElem(const ValidationBoolElem& validationElem, const bool statValue, const std::string& statName) const;
+	const std::string makeLineFromFloatElem(const ValidationFloatElem& validationElem, const float statValue, const std::string& statName) const;
 
 	const std::string generateTxtFormattedReport(const PrimDataCollection& asset) const;
 
-	inline const std::string makeCsvValueFromValidationElem(const ValidationBoolElem& validationElem, const bool statValue) const;
-	inline const std::string makeCsvValueFromValidationElem(const ValidationStringElem& validationElem, const bool isValid) const;
+	inline void addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationBoolElem& validationElem, const bool statValue) const;
+	inline void addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationStringElem& validationElem, const bool isValid) const;
+	inline void addCsvFieldFromValidationElem(CsvFileWriter& writer, const ValidationFloatElem& validationElem, const float statValue) const;
+
+	void outputCsvHeader(CsvFileWriter& writer) const override;
 
 	void outputToConsole(const std::string& txtReport);
 	void outputToLog(const std::string& txtReport);
@@ -75,17 +112,22 @@ public:
 
 	void outputReports(const PrimDataCollection& asset) override;
 
-	void outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep = ',') override;
+	void outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const override;
 	void outputToLog(const PrimDataCollection& asset) override;
 };
 
 class ResultOutputterBudget : public ResultOutputterBase
 {
-	const std::string makeLineFromBudgetElem(const BudgetUint32Elem& budgetElem, const uint32_t statValue, const std::string& statName) const;
+	// BudgetElem: BudgetUint32Elem or BudgetFloatElem with matching StatValue
+	template<typename BudgetElem, typename StatValue>
+	const std::string makeLineFromBudgetElem(const BudgetElem& budgetElem, const StatValue statValue, const std::string& statName) const;
 
 	const std::string generateTxtFormattedReport(const PrimDataCollection& asset) const;
 
-	const std::string makeCsvValueFromBudgetElem(const BudgetUint32Elem& budgetElem, const uint32_t statValue) const;
+	template<typename BudgetElem, typename StatValue>
+	void addCsvFieldFromBudgetElem(CsvFileWriter& writer, const BudgetElem& budgetElem, const StatValue statValue) const;
+
+	void outputCsvHeader(CsvFileWriter& writer) const override;
 
 	void outputToConsole(const std::string& txtReport);
 	void outputToLog(const std::string& txtReport);
@@ -95,6 +137,6 @@ public:
 
 	void outputReports(const PrimDataCollection& asset) override;
 
-	void outputToCsv(const PrimDataCollection& asset, const std::filesystem::path& filepath, const char sep = ',') override;
+	void outputToCsv(const PrimDataCollection& asset, CsvFileWriter& writer) const override;
 	void outputToLog(const PrimDataCollection& asset) override;
 };
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "ProcessingStats.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+void PhaseTimings::merge(const PhaseTimings& other)
+{
+	io += other.io;
+	classification += other.classification;
+	tokenization += other.tokenization;
+	nameHandling += other.nameHandling;
+	reportFormatting += other.reportFormatting;
+	csvWriting += other.csvWriting;
+	logging += other.logging;
+};
+
+// --------------------------------
+void ParsePhaseSamples::merge(const ParsePhaseSamples& other)
+{
+	classification += other.classification;
+	tokenization += other.tokenization;
+	nameHandling += other.nameHandling;
+	sampledLineCount += other.sampledLineCount;
+};
+
+void ParsePhaseSamples::extrapolateTo(PhaseTimings& phases, uint64_t lineCount) const
+{
+	if (sampledLineCount == 0)
+	{
+		return;
+	}
+	const double scale = double(lineCount) / sampledLineCount;
+	auto extrapolate = [scale](std::chrono::nanoseconds sampled) { return std::chrono::nanoseconds(int64_t(sampled.count() * scale)); };
+
+	phases.classification += extrapolate(classification);
+	phases.tokenization += extrapolate(tokenization);
+	phases.nameHandling += extrapolate(nameHandling);
+};
+
+// --------------------------------
+void RunStats::addFile(FileStats&& stats)
+{
+	fileStats.push_back(std::move(stats));
+};
+
+FileStats RunStats::getAggregate() const
+{
+	FileStats aggregate;
+	for (const FileStats& stats : fileStats)
+	{
+		aggregate.byteCount += stats.byteCount;
+		aggregate.lineCount += stats.lineCount;
+		aggregate.phases.merge(stats.phases);
+	}
+	aggregate.totalTime = std::chrono::steady_clock::now() - startTime;
+	return aggregate;
+};
+
+uint64_t RunStats::getPeakRss()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS memoryCounters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+	{
+		return memoryCounters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+		// reported in KiB on linux
+		return uint64_t(usage.ru_maxrss) * 1024;
+	}
+	return 0;
+#endif
+};
+
+void RunStats::appendJsonString(std::string& json, std::string_view str)
+{
+	json += '"';
+	for (const char c : str)
+	{
+		switch (c)
+		{
+		case '"':  json += "\\\""; break;
+		case '\\': json += "\\\\"; break;
+		case '\n': json += "\\n";  break;
+		case '\r': json += "\\r";  break;
+		case '\t': json += "\\t";  break;
+		default:
+			if (uint8_t(c) < 0x20)
+			{
+				std::format_to(std::back_inserter(json), "\\u{:04x}", uint8_t(c));
+			}
+			else
+			{
+				json += c;
+			}
+			break;
+		}
+	}
+	json += '"';
+};
+
+void RunStats::appendJsonFileStats(std::string& json, const FileStats& stats, std::string_view indent)
+{
+	auto toMs = [](std::chrono::nanoseconds duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+	const double seconds = std::chrono::duration<double>(stats.totalTime).count();
+
+	std::format_to(std::back_inserter(json),
+		"{0}\"bytes\": {1},\n"
+		"{0}\"lines\": {2},\n"
+		"{0}\"total_ms\": {3:.3f},\n"
+		"{0}\"bytes_per_sec\": {4:.0f},\n"
+		"{0}\"lines_per_sec\": {5:.0f},\n"
+		"{0}\"phases_ms\": {{\n"
+		"{0}  \"io\": {6:.3f},\n"
+		"{0}  \"classification\": {7:.3f},\n"
+		"{0}  \"tokenization\": {8:.3f},\n"
+		"{0}  \"name_handling\": {9:.3f},\n"
+		"{0}  \"report_formatting\": {10:.3f},\n"
+		"{0}  \"csv_writing\": {11:.3f},\n"
+		"{0}  \"logging\": {12:.3f}\n"
+		"{0}}}\n",
+		indent,
+		stats.byteCount,
+		stats.lineCount,
+		toMs(stats.totalTime),
+		seconds > 0 ? stats.byteCount / seconds : 0.0,
+		seconds > 0 ? stats.lineCount / seconds : 0.0,
+		toMs(stats.phases.io),
+		toMs(stats.phases.classification),
+		toMs(stats.phases.tokenization),
+		toMs(stats.phases.nameHandling),
+		toMs(stats.phases.reportFormatting),
+		toMs(stats.phases.csvWriting),
+		toMs(stats.phases.logging)
+	);
+};
+
+std::string RunStats::toJson() const
+{
+	std::string json = "{\n  \"files\": [";
+	for (size_t i = 0; i < fileStats.size(); i++)
+	{
+		json += i == 0 ? "\n    {\n      \"path\": " : ",\n    {\n      \"path\": ";
+		appendJsonString(json, fileStats[i].filepath.generic_string());
+		json += ",\n";
+		appendJsonFileStats(json, fileStats[i], "      ");
+		json += "    }";
+	}
+	json += fileStats.empty() ? "],\n" : "\n  ],\n";
+
+	std::format_to(std::back_inserter(json), "  \"aggregate\": {{\n    \"file_count\": {},\n", fileStats.size());
+	appendJsonFileStats(json, getAggregate(), "    ");
+	std::format_to(std::back_inserter(json),
+		"  }},\n"
+		"  \"peak_rss_bytes\": {},\n"
+		"  \"parse_phase_sample_interval\": {}\n"
+		"}}\n",
+		getPeakRss(),
+		ParsePhaseSamples::sampleInterval
+	);
+	return json;
+};
\ No newline at end of file
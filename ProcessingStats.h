@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// time spent in each phase of processing & outputting a file
+// parse phases of chunked files are summed over all chunk threads, so they can exceed the wall time
+struct PhaseTimings
+{
+	std::chrono::nanoseconds io{};
+	std::chrono::nanoseconds classification{};
+	std::chrono::nanoseconds tokenization{};
+	std::chrono::nanoseconds nameHandling{};
+	std::chrono::nanoseconds reportFormatting{};
+	std::chrono::nanoseconds csvWriting{};
+	std::chrono::nanoseconds logging{};
+
+	void merge(const PhaseTimings& other);
+};
+
+// parse phases are only timed on every sampleInterval-th line, reading the clock on every line would dominate them
+struct ParsePhaseSamples
+{
+	static constexpr uint64_t sampleInterval = 64; // power of 2
+
+	std::chrono::nanoseconds classification{};
+	std::chrono::nanoseconds tokenization{};
+	std::chrono::nanoseconds nameHandling{};
+	uint64_t sampledLineCount = 0;
+
+	void merge(const ParsePhaseSamples& other);
+	// estimate phase times for all lineCount lines
+	void extrapolateTo(PhaseTimings& phases, uint64_t lineCount) const;
+};
+
+struct FileStats
+{
+	std::filesystem::path filepath;
+	uint64_t byteCount = 0;
+	uint64_t lineCount = 0;
+	// processing & outputting the file
+	std::chrono::nanoseconds totalTime{};
+	PhaseTimings phases;
+};
+
+// measures scope duration with steady_clock, adds it to target on destruction
+class ScopedPhaseTimer
+{
+	std::chrono::nanoseconds* target;
+	const std::chrono::steady_clock::time_point startTime;
+
+public:
+	// null target disables timing
+	ScopedPhaseTimer(std::chrono::nanoseconds* target) : target(target), startTime(target ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {};
+	~ScopedPhaseTimer()
+	{
+		if (target)
+		{
+			*target += std::chrono::steady_clock::now() - startTime;
+		}
+	};
+
+	ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+	ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+// per file & aggregate stats of a run, output as json
+class RunStats
+{
+	std::vector<FileStats> fileStats;
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	static void appendJsonString(std::string& json, std::string_view str);
+	static void appendJsonFileStats(std::string& json, const FileStats& stats, std::string_view indent);
+
+public:
+	void addFile(FileStats&& stats);
+
+	// sum of all files, total time is the wall time of the run so far
+	FileStats getAggregate() const;
+
+	// peak resident set size of the process in bytes, 0 if unavailable
+	static uint64_t getPeakRss();
+
+	std::string toJson() const;
+};
\ No newline at end of file
@@ -1,63 +1,77 @@
 #include "Processors.h"
 #include "DataCollection.h"
 
-std::string_view LineProcessor::getLineType() const
+LineType LineProcessor::getLineType() const
 {
-	return std::string_view(lineStr.data(), lineStr.find(' '));
+	return classifyLine(line);
 }
 
 uint32_t LineProcessor::getValueCount() const
 {
-	uint32_t valueCount = 0;
+	// all values are prefixed with a space
+	// therfore space count = values count (unless malformed file)
+	return spaceCount;
+}
+
+LineValues LineProcessor::getValues() const
+{
+	return LineValues(line);
+}
 
-	for (char character : lineStr)
+std::string_view LineProcessor::getValuesText() const
+{
+	const size_t valuesStart = line.find_first_not_of(" \t", std::min(line.find_first_of(" \t"), line.size()));
+	if (valuesStart == line.npos)
 	{
-		// all values are prefixed with a space
-		// therfore space count = values count (unless malformed file)
-		if (character == ' ') { valueCount++; }
+		return std::string_view();
 	}
-	return valueCount;
+	return line.substr(valuesStart, line.find_last_not_of(" \t") + 1 - valuesStart);
 }
 
-std::vector<std::string_view> LineProcessor::getValues() const
+bool LineProcessor::getVertexPosition(std::array<float, 3>& position) const
 {
-	std::vector<std::string_view> values;
-
-	size_t lastDelimiter = 0;
-	for (size_t i = 0; i < lineStr.size(); i++)
+	// parse in place after the "v" keyword, from_chars stops at the next delimiter
+	const char* curr = line.data() + 1;
+	const char* const end = line.data() + line.size();
+	for (float& axisValue : position)
 	{
-		if (lineStr[i] == ' ')
+		while (curr != end && *curr == ' ') { curr++; }
+		const std::from_chars_result result = std::from_chars(curr, end, axisValue);
+		if (result.ec != std::errc())
 		{
-			// skip first delim since represent line type not value
-			if (lastDelimiter != 0)
-			{
-				values.push_back(std::string_view(
-					lineStr.data() + lastDelimiter,
-					lineStr.data() + i
-				));
-			}
-			lastDelimiter = i;
+			return false;
 		}
+		curr = result.ptr;
 	}
-	// add last value since no delim at eol
-	if (lastDelimiter != 0)
-	{
-		values.push_back(std::string_view(
-			lineStr.data() + lastDelimiter,
-			lineStr.data() + lineStr.size()
-		));
-	}
-	return values;
+	return true;
 }
 
 
 // --------------------------------
-FileProcessor::FileProcessor(const std::filesystem::path& filepath, const ProcessingSettings& settings, LogManager& loggingManager)
+FileProcessor::FileProcessor(const std::filesystem::path& filepath, const ProcessingSettings& settings, LogManager& loggingManager, WorkerPool* chunkWorkerPool,
+	FileArena* arena, UniqueVertexMemoryBudget* uniqueVertexMemoryBudget)
 	: filepath(filepath)
-	, settings(settings)
 	, loggingManager(loggingManager)
-	, PrimDataCollections({ PrimDataCollection(filepath.stem().string()) }) //default obj for malformed file lacking "g" or "o" lines or when settings mode:File
-{};
+	, chunkWorkerPool(chunkWorkerPool)
+	, memoryResource(arena ? arena : std::pmr::get_default_resource())
+	, deferredWarnings(memoryResource)
+	, deferredFaceIndices(memoryResource)
+	, faceVertexIndices(memoryResource)
+	, topologyEdgeKeys(memoryResource)
+	, referencedVertBits(memoryResource)
+	, collectionFirstVertIndices(1, 0, memoryResource)
+	, ownUniqueVertexMemoryBudget(uniqueVertexMemoryBudget ? nullptr : std::make_unique<UniqueVertexMemoryBudget>(settings.uniqueVertMemoryCap))
+	, uniqueVertexMemoryBudget(uniqueVertexMemoryBudget ? *uniqueVertexMemoryBudget : *ownUniqueVertexMemoryBudget)
+	, uniqueVertexTable(settings.weldEpsilon, this->uniqueVertexMemoryBudget)
+	, leadingVertexTable(settings.weldEpsilon, this->uniqueVertexMemoryBudget)
+	, deferredWarningTallies(memoryResource)
+	, currentCollection(removeCompressionExtension(filepath).stem().string()) //default obj for malformed file lacking "g" or "o" lines or when settings mode:File
+	, settings(settings)
+	, relevantLineTypes(settings.getRelevantLineTypes())
+	, resultStore(memoryResource)
+{
+	stats.filepath = filepath;
+};
 
 const std::filesystem::path& FileProcessor::getFilepath() const
 {
@@ -66,130 +80,756 @@ const std::filesystem::path& FileProcessor::getFilepath() const
 
 PrimDataCollection& FileProcessor::getCurrentObject()
 {
-	return PrimDataCollections.back();
+	return currentCollection;
 }
 
-void FileProcessor::processFile()
+bool FileProcessor::hasStoppedEarly() const
 {
-	loggingManager.logMsgProcessing(LogPresetProcessing::ProcessingStart_log);
-	loggingManager.logMsgIo(LogPresetIo::InPathRead_log, filepath);
-	auto start_time = std::chrono::system_clock::now(); // TODO: move this?
+	return bStoppedEarly;
+}
 
-	std::ifstream file(filepath, std::ios::binary);
-	LineProcessor lineProcessor;
+bool FileProcessor::hasReadFailed() const
+{
+	return bReadFailed;
+}
 
-	lineNum = 0;
-	// itt over lines in file
-	while (getline(file, lineProcessor.lineStr))
+FileStats& FileProcessor::getStats()
+{
+	return stats;
+}
+
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+uint64_t FileProcessor::getAllocatingLineCount() const
+{
+	return allocatingLineCount;
+}
+#endif
+
+void FileProcessor::setCollectionClosedCallback(std::function<void(const PrimDataCollection&)> callback)
+{
+	onCollectionClosed = std::move(callback);
+}
+
+bool FileProcessor::isStreaming() const
+{
+	return bool(onCollectionClosed);
+}
+
+void FileProcessor::setMaterialLibraryCache(MaterialLibraryCache* cache)
+{
+	materialLibraryCache = cache;
+}
+
+void FileProcessor::addCollection(std::string_view name)
+{
+	closeCurrentCollection();
+	currentCollection.reset(name);
+	resultGrowthCount++;
+}
+
+void FileProcessor::closeCurrentCollection()
+{
+	if (settings.bCountUniqueVerts)
 	{
-		lineNum++;
-		const std::string_view lineType = lineProcessor.getLineType();
-		// prim lineType
-		if (lineType == "v" && settings.areVertsRelevent())
+		resetUniqueVertexTable();
+	}
+	if (settings.bAnalyzeTopology)
+	{
+		closeCollectionTopology(getCurrentObject());
+	}
+
+	if (onCollectionClosed)
+	{
+		if (settings.bAnalyzeTopology)
+		{
+			// later faces can't be taken into account once streamed
+			currentCollection.isolatedVertCount = countIsolatedVerts(currentCollection.vertCount, collectionFirstVertIndices.back());
+			collectionFirstVertIndices.back() = uint32_t(faceIndexElementCounts[FaceIndexPosition]);
+		}
+		// later "mtllib" lines can't be taken into account once streamed
+		if (loadMaterialLibraries())
+		{
+			currentCollection.resolveMaterials(materialLibraries);
+		}
+		onCollectionClosed(currentCollection);
+	}
+	else
+	{
+		if (settings.bAnalyzeTopology)
+		{
+			collectionFirstVertIndices.push_back(uint32_t(faceIndexElementCounts[FaceIndexPosition]));
+		}
+		resultStore.append(currentCollection);
+	}
+}
+
+bool FileProcessor::loadMaterialLibraries()
+{
+	if (materialLibraryCache == nullptr)
+	{
+		return false;
+	}
+
+	while (materialLibraries.size() < materialLibraryPaths.size())
+	{
+		const std::filesystem::path& libraryPath = materialLibraryPaths[materialLibraries.size()];
+		std::shared_ptr<const MaterialLibrary> library = materialLibraryCache->get(libraryPath);
+		if (!library->isLoaded())
+		{
+			loggingManager.logMsgIo(LogPresetIo::MtlFileReadFail_warn, libraryPath);
+		}
+		materialLibraries.push_back(std::move(library));
+	}
+	return true;
+}
+
+void FileProcessor::logProcessingWarning(LogPresetProcessing code)
+{
+	resultGrowthCount++;
+	if (bDeferWarnings)
+	{
+		// the first occurrences in the file are always among the first occurrences in each chunk
+		ProcessingWarningTally& tally = deferredWarningTallies[code];
+		tally.add(lineNum);
+		const uint32_t warningLimit = loggingManager.getProcessingWarningLimit();
+		if (warningLimit == 0 || tally.count <= warningLimit)
+		{
+			deferredWarnings.push_back({ code, lineNum });
+		}
+	}
+	else
+	{
+		loggingManager.logMsgProcessing(code, lineNum);
+	}
+}
+
+void FileProcessor::checkFaceIndices(std::string_view line)
+{
+	// parse in place after the "f" keyword, from_chars stops at the next '/' or delimiter
+	const char* curr = line.data() + 1;
+	const char* const end = line.data() + line.size();
+	bool bFaceResolved = true;
+	faceVertexIndices.clear();
+	const size_t faceCapacityBefore = faceVertexIndices.capacity();
+	while (true)
+	{
+		while (curr != end && *curr == ' ') { curr++; }
+		if (curr == end)
 		{
-			PrimDataCollection& currObj = getCurrentObject();
-			currObj.vertCount++;
+			break;
+		}
 
-			if (currObj.hasVertColor == false) // avoid getting values when not needed
+		bool bTokenValid = true;
+		for (uint8_t element = FaceIndexPosition; element <= FaceIndexNormal && curr != end && *curr != ' '; element++)
+		{
+			// vt is empty in v//vn
+			if (*curr != '/')
 			{
-				if (lineProcessor.getValueCount() == 6)
+				int64_t index = 0;
+				const std::from_chars_result result = std::from_chars(curr, end, index);
+				if (result.ec != std::errc())
 				{
-					// verts with color are specified like: x y z r g b
-					// NOTE: color support is technically unofficial and may differ from author to author *cough* *cough* Zbrush
-					currObj.hasVertColor = true;
+					bTokenValid = false;
+					break;
 				}
+				const uint32_t resolvedIndex = checkFaceIndex(FaceIndexElement(element), index);
+				if (element == FaceIndexPosition)
+				{
+					bFaceResolved &= resolvedIndex != 0;
+					if (settings.bAnalyzeTopology)
+					{
+						faceVertexIndices.push_back(resolvedIndex);
+					}
+				}
+				curr = result.ptr;
+			}
+			if (curr != end && *curr == '/')
+			{
+				curr++;
 			}
 		}
-		else if (lineType == "vn" && settings.areVertsRelevent())
+
+		// unparsable or more than 3 elements
+		if (!bTokenValid || (curr != end && *curr != ' '))
 		{
-			getCurrentObject().hasVertNormals = true;
+			bFaceResolved = false;
+			getCurrentObject().invalidFaceIndexCount++;
+			while (curr != end && *curr != ' ') { curr++; }
 		}
-		else if (lineType == "vt" && settings.areVertsRelevent())
+	}
+
+	if (faceVertexIndices.capacity() != faceCapacityBefore)
+	{
+		resultGrowthCount++;
+	}
+
+	// faces with invalid indices have no known topology
+	if (settings.bAnalyzeTopology && bFaceResolved)
+	{
+		addFaceTopology(getCurrentObject());
+	}
+}
+
+void FileProcessor::addFaceTopology(PrimDataCollection& collection)
+{
+	const size_t edgeCapacityBefore = topologyEdgeKeys.capacity();
+	const size_t faceVertCount = faceVertexIndices.size();
+
+	bool bDegenerate = faceVertCount < 3;
+	for (size_t i = 0; i < faceVertCount && !bDegenerate; i++)
+	{
+		for (size_t j = i + 1; j < faceVertCount && !bDegenerate; j++)
 		{
-			getCurrentObject().hasUvs = true;
+			bDegenerate = faceVertexIndices[j] == faceVertexIndices[i];
 		}
-		else if (lineType == "p" && settings.arePointsRelevent())
+	}
+	collection.degenerateFaceCount += bDegenerate;
+
+	for (size_t i = 0; i < faceVertCount; i++)
+	{
+		const uint32_t vertIndex = faceVertexIndices[i];
+		// degenerate faces are reported on their own, their edges would only add false non manifold edges
+		if (!bDegenerate)
 		{
-			getCurrentObject().pointCount++;
+			const uint32_t nextVertIndex = faceVertexIndices[i + 1 == faceVertCount ? 0 : i + 1];
+			topologyEdgeKeys.push_back(uint64_t(std::min(vertIndex, nextVertIndex)) << 32 | std::max(vertIndex, nextVertIndex));
 		}
-		else if (lineType == "l" && settings.areLinesRelevent())
+
+		const size_t bitWord = (vertIndex - 1) >> 6;
+		if (bitWord >= referencedVertBits.size())
 		{
-			getCurrentObject().lineCount++;
+			referencedVertBits.resize(std::max(bitWord + 1, referencedVertBits.size() * 2), 0);
+			resultGrowthCount++;
 		}
-		else if (lineType == "f" && settings.areFacesRelevent())
+		referencedVertBits[bitWord] |= uint64_t(1) << ((vertIndex - 1) & 63);
+	}
+
+	if (topologyEdgeKeys.capacity() != edgeCapacityBefore)
+	{
+		resultGrowthCount++;
+	}
+}
+
+void FileProcessor::closeCollectionTopology(PrimDataCollection& collection)
+{
+	// sort instead of hashing, runs of equal keys are the faces sharing an edge
+	std::sort(topologyEdgeKeys.begin(), topologyEdgeKeys.end());
+	for (size_t runStart = 0; runStart < topologyEdgeKeys.size();)
+	{
+		size_t runEnd = runStart + 1;
+		while (runEnd < topologyEdgeKeys.size() && topologyEdgeKeys[runEnd] == topologyEdgeKeys[runStart]) { runEnd++; }
+
+		const size_t faceCount = runEnd - runStart;
+		collection.boundaryEdgeCount    += faceCount == 1;
+		collection.nonManifoldEdgeCount += faceCount > 2;
+		runStart = runEnd;
+	}
+	topologyEdgeKeys.clear();
+}
+
+uint32_t FileProcessor::countIsolatedVerts(uint32_t vertCount, uint32_t firstVertIndex) const
+{
+	uint32_t isolatedCount = 0;
+	for (uint64_t vertIndex = firstVertIndex; vertIndex < uint64_t(firstVertIndex) + vertCount; vertIndex++)
+	{
+		const size_t bitWord = vertIndex >> 6;
+		isolatedCount += bitWord >= referencedVertBits.size() || (referencedVertBits[bitWord] & (uint64_t(1) << (vertIndex & 63))) == 0;
+	}
+	return isolatedCount;
+}
+
+uint32_t FileProcessor::checkFaceIndex(FaceIndexElement element, int64_t index)
+{
+	// positive indices count from the first element of the file, negative ones back from the last element defined so far
+	const uint64_t elementCount = faceIndexElementCounts[element];
+	const uint64_t reach = index > 0 ? uint64_t(index) : uint64_t(0) - uint64_t(index);
+	if (index != 0 && reach <= elementCount)
+	{
+		return uint32_t(index > 0 ? reach : elementCount + 1 - reach);
+	}
+
+	if (bDeferWarnings && index != 0)
+	{
+		deferredFaceIndices.push_back({ uint32_t(resultStore.size()), element, reach - elementCount });
+		resultGrowthCount++;
+	}
+	else
+	{
+		getCurrentObject().invalidFaceIndexCount++;
+	}
+	return 0;
+}
+
+void FileProcessor::addUniqueVertex(PrimDataCollection& collection, const std::array<float, 3>& position)
+{
+	const uint64_t uniqueCountBefore = uniqueVertexTable.getUniqueCount();
+	uniqueVertexTable.insert(position);
+	const uint64_t uniqueCount = uniqueVertexTable.getUniqueCount();
+	if (uniqueCount != uniqueCountBefore)
+	{
+		// new positions may grow the table
+		resultGrowthCount++;
+		collection.uniqueVertCount = uint32_t(uniqueCount);
+		if (uniqueVertexTable.isOverCap() && !collection.uniqueVertCountIsUpperBound)
 		{
-			getCurrentObject().faceTotalCount++;
-			const uint32_t vertCount = lineProcessor.getValueCount();
-			switch (vertCount)
+			collection.uniqueVertCountIsUpperBound = true;
+			logProcessingWarning(LogPresetProcessing::UniqueVertexCapReached_warn);
+		}
+	}
+}
+
+void FileProcessor::resetUniqueVertexTable()
+{
+	if (bDeferWarnings && resultStore.empty())
+	{
+		// leading table is still empty, so this also leaves an empty table for the next collection
+		leadingVertexTable.swap(uniqueVertexTable);
+	}
+	else
+	{
+		uniqueVertexTable.clear();
+	}
+}
+
+template<DataCollectionGrouping grouping>
+void FileProcessor::processLine(const LineProcessor& lineProcessor, const LineType lineType)
+{
+	// single check for all irrelevant & unknown lines
+	if ((relevantLineTypes & lineTypeBit(lineType)) == 0)
+	{
+		return;
+	}
+
+	switch (lineType)
+	{
+	// prim lineType
+	case LineType::Vertex:
+	{
+		PrimDataCollection& currObj = getCurrentObject();
+		currObj.vertCount++;
+		faceIndexElementCounts[FaceIndexPosition]++;
+
+		if (currObj.hasVertColor == false) // avoid getting values when not needed
+		{
+			if (lineProcessor.getValueCount() == 6)
 			{
-			case 3:  getCurrentObject().faceTriCount++;  break;
-			case 4:  getCurrentObject().faceQuadCount++; break;
-			default: getCurrentObject().faceNgonCount++; break;
+				// verts with color are specified like: x y z r g b
+				// NOTE: color support is technically unofficial and may differ from author to author *cough* *cough* Zbrush
+				currObj.hasVertColor = true;
 			}
 		}
-		// container lineType
-		else if (lineType == "o")
+
+		if (settings.bComputeBounds || settings.bCountUniqueVerts)
 		{
-			const auto& lineValues = lineProcessor.getValues();
-			if (settings.grouping == DataCollectionGrouping::Object)
+			std::array<float, 3> position;
+			if (lineProcessor.getVertexPosition(position))
 			{
-				// treat as asset grouping
-				if (!lineValues.empty())
+				if (settings.bComputeBounds)
 				{
-					PrimDataCollections.push_back(PrimDataCollection{ lineValues.front() });
-					if (lineValues.size() > 1)
-					{
-						loggingManager.logMsgProcessing(LogPresetProcessing::ONameMoreThanOne_warn, lineNum);
-					}
+					currObj.addVertexPosition(position);
 				}
-				else
+				if (settings.bCountUniqueVerts)
 				{
-					loggingManager.logMsgProcessing(LogPresetProcessing::ONameMissing_warn, lineNum);
+					addUniqueVertex(currObj, position);
 				}
 			}
-			else if (settings.grouping == DataCollectionGrouping::File && settings.areSubGroupsRelevent())
+			else
 			{
-				// treat as sub grouping
-				getCurrentObject().subgroupCount++;
+				logProcessingWarning(LogPresetProcessing::VertexPositionInvalid_warn);
 			}
 		}
-		else if (lineType == "g")
+		break;
+	}
+	case LineType::VertexNormal:
+		getCurrentObject().hasVertNormals = true;
+		faceIndexElementCounts[FaceIndexNormal]++;
+		break;
+	case LineType::VertexUv:
+		getCurrentObject().hasUvs = true;
+		faceIndexElementCounts[FaceIndexUv]++;
+		break;
+	case LineType::Point:
+		getCurrentObject().pointCount++;
+		break;
+	case LineType::Line:
+		getCurrentObject().lineCount++;
+		break;
+	case LineType::Face:
+	{
+		getCurrentObject().faceTotalCount++;
+		const uint32_t vertCount = lineProcessor.getValueCount();
+		switch (vertCount)
 		{
-			const auto& lineValues = lineProcessor.getValues();
-			if (settings.grouping == DataCollectionGrouping::Vertexgroup)
+		case 3:  getCurrentObject().faceTriCount++;  break;
+		case 4:  getCurrentObject().faceQuadCount++; break;
+		default: getCurrentObject().faceNgonCount++; break;
+		}
+		// same count as a fan triangulation
+		getCurrentObject().faceTriEquivalentCount += vertCount > 2 ? vertCount - 2 : 0;
+
+		if (settings.bCheckFaceIndices)
+		{
+			checkFaceIndices(lineProcessor.line);
+		}
+		break;
+	}
+	// container lineType
+	case LineType::Object:
+	{
+		if constexpr (grouping == DataCollectionGrouping::Object)
+		{
+			// treat as asset grouping
+			const LineValues lineValues = lineProcessor.getValues();
+			if (!lineValues.empty())
 			{
-				// treat as asset grouping
-				if (!lineValues.empty() && lineValues.front() != "off")
+				addCollection(lineValues.front());
+				if (std::next(lineValues.begin()) != lineValues.end())
 				{
-					PrimDataCollections.push_back(PrimDataCollection{ lineValues.front() });
-					if (lineValues.size() > 1)
-					{
-						loggingManager.logMsgProcessing(LogPresetProcessing::GNameMoreThanOne_warn, lineNum);
-					}
+					logProcessingWarning(LogPresetProcessing::ONameMoreThanOne_warn);
 				}
-				else if (lineValues.empty())
+			}
+			else
+			{
+				logProcessingWarning(LogPresetProcessing::ONameMissing_warn);
+			}
+		}
+		else if constexpr (grouping == DataCollectionGrouping::File)
+		{
+			// treat as sub grouping
+			getCurrentObject().subgroupCount++;
+		}
+		break;
+	}
+	case LineType::Group:
+	{
+		const LineValues lineValues = lineProcessor.getValues();
+		if constexpr (grouping == DataCollectionGrouping::Vertexgroup)
+		{
+			// treat as asset grouping
+			if (!lineValues.empty() && lineValues.front() != "off")
+			{
+				addCollection(lineValues.front());
+				if (std::next(lineValues.begin()) != lineValues.end())
 				{
-					loggingManager.logMsgProcessing(LogPresetProcessing::GNameMissing_warn, lineNum);
+					logProcessingWarning(LogPresetProcessing::GNameMoreThanOne_warn);
 				}
 			}
-			else if (settings.grouping == DataCollectionGrouping::Object
-				&& settings.areSubGroupsRelevent()
-				&& lineValues.front() != "off"
-				)
+			else if (lineValues.empty())
+			{
+				logProcessingWarning(LogPresetProcessing::GNameMissing_warn);
+			}
+		}
+		else if constexpr (grouping == DataCollectionGrouping::Object)
+		{
+			// treat as sub grouping
+			if (!lineValues.empty() && lineValues.front() != "off")
 			{
-				// treat as sub grouping
 				getCurrentObject().subgroupCount++;
 			}
 		}
-		// other
-		else if (lineType == "usemtl" && settings.areMaterialsRelevent())
+		break;
+	}
+	// other
+	case LineType::UseMaterial:
+	{
+		// whole rest of the line, like "newmtl" names, see MaterialLibrary
+		std::string_view materialName = lineProcessor.getValuesText();
+		if (!materialName.empty() && getCurrentObject().addMaterial(materialName))
+		{
+			resultGrowthCount++;
+		}
+		break;
+	}
+	case LineType::MaterialLibrary:
+	{
+		// libraries are relative to the obj, several may be listed on one line
+		for (const std::string_view libraryName : lineProcessor.getValues())
+		{
+			materialLibraryPaths.push_back(filepath.parent_path() / libraryName);
+			resultGrowthCount++;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+template<DataCollectionGrouping grouping>
+void FileProcessor::processLineSampled(const LineProcessor& lineProcessor)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+	const LineType lineType = lineProcessor.getLineType();
+	const auto classifiedTime = std::chrono::steady_clock::now();
+	processLine<grouping>(lineProcessor, lineType);
+	const auto endTime = std::chrono::steady_clock::now();
+
+	phaseSamples.classification += classifiedTime - startTime;
+	switch (lineType)
+	{
+	case LineType::Object:
+	case LineType::Group:
+	case LineType::UseMaterial:
+	case LineType::MaterialLibrary:
+		phaseSamples.nameHandling += endTime - classifiedTime;
+		break;
+	default:
+		phaseSamples.tokenization += endTime - classifiedTime;
+		break;
+	}
+	phaseSamples.sampledLineCount++;
+}
+
+template<DataCollectionGrouping grouping, typename Reader>
+void FileProcessor::processLines(Reader& reader)
+{
+	LineProcessor lineProcessor;
+	const bool bSamplePhases = settings.bCollectStats;
+
+	auto processCurrentLine = [&]()
+		{
+			if (bSamplePhases && (lineNum & (ParsePhaseSamples::sampleInterval - 1)) == 0)
+			{
+				processLineSampled<grouping>(lineProcessor);
+			}
+			else
+			{
+				processLine<grouping>(lineProcessor, lineProcessor.getLineType());
+			}
+		};
+
+	// itt over lines in file
+	while (reader.getLine(lineProcessor.line, lineProcessor.spaceCount))
+	{
+		lineNum++;
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+		// classifying & tokenizing must never allocate, only growing the results may
+		const uint64_t allocationCountBefore = getThreadAllocationCount();
+		const uint64_t resultGrowthCountBefore = resultGrowthCount;
+		processCurrentLine();
+		if (getThreadAllocationCount() != allocationCountBefore && resultGrowthCount == resultGrowthCountBefore)
+		{
+			allocatingLineCount++;
+		}
+#else
+		processCurrentLine();
+#endif
+
+		// counts only grow, so once every budget is exceeded the verdict is final
+		// only applies to file grouping since later collections are still undecided otherwise
+		if constexpr (grouping == DataCollectionGrouping::File)
+		{
+			if (settings.bFailFast
+				&& (lineNum & (failFastCheckInterval - 1)) == 0
+				&& settings.budgets.isExceededByAll(getCurrentObject())
+				)
+			{
+				bStoppedEarly = true;
+				loggingManager.logMsgProcessing(LogPresetProcessing::ProcessingFailFast_log, lineNum);
+				return;
+			}
+		}
+	}
+}
+
+template<typename Reader>
+void FileProcessor::processLinesForGrouping(Reader& reader)
+{
+	switch (settings.grouping)
+	{
+	case DataCollectionGrouping::File:        processLines<DataCollectionGrouping::File>(reader);        break;
+	case DataCollectionGrouping::Object:      processLines<DataCollectionGrouping::Object>(reader);      break;
+	case DataCollectionGrouping::Vertexgroup: processLines<DataCollectionGrouping::Vertexgroup>(reader); break;
+	}
+}
+
+void FileProcessor::processChunked(std::string_view fileData)
+{
+	const size_t chunkCount = std::clamp<size_t>(fileData.size() / minChunkSize, 1, size_t(chunkWorkerPool->getThreadCount()) * 4);
+	const size_t targetChunkSize = fileData.size() / chunkCount;
+
+	// chunk processors are not moveable (reference members), so keep them on the heap
+	std::vector<std::unique_ptr<FileProcessor>> chunkProcessors;
+	std::vector<std::future<void>> chunkResults;
+	chunkProcessors.reserve(chunkCount);
+	chunkResults.reserve(chunkCount);
+
+	size_t chunkStart = 0;
+	while (chunkStart < fileData.size())
+	{
+		// extend chunk to end of line so no line is split between chunks
+		size_t chunkEnd = chunkStart + targetChunkSize;
+		if (chunkEnd >= fileData.size() || chunkProcessors.size() + 1 == chunkCount)
+		{
+			chunkEnd = fileData.size();
+		}
+		else
+		{
+			const size_t newlinePos = fileData.find('\n', chunkEnd);
+			chunkEnd = newlinePos == fileData.npos ? fileData.size() : newlinePos + 1;
+		}
+
+		auto& chunkProcessor = chunkProcessors.emplace_back(std::make_unique<FileProcessor>(filepath, settings, loggingManager, nullptr, nullptr, &uniqueVertexMemoryBudget));
+		chunkProcessor->bDeferWarnings = true;
+
+		const std::string_view chunkData = fileData.substr(chunkStart, chunkEnd - chunkStart);
+		chunkResults.push_back(chunkWorkerPool->submit([processor = chunkProcessor.get(), chunkData]()
+			{
+				InputChunkReader chunkReader(chunkData);
+				processor->processLinesForGrouping(chunkReader);
+			}));
+
+		chunkStart = chunkEnd;
+	}
+
+	// merge in file order
+	for (size_t i = 0; i < chunkProcessors.size(); i++)
+	{
+		chunkResults[i].get();
+		mergeChunk(*chunkProcessors[i]);
+		chunkProcessors[i].reset();
+	}
+}
+
+void FileProcessor::mergeChunk(FileProcessor& chunkProcessor)
+{
+	for (const DeferredWarning& warning : chunkProcessor.deferredWarnings)
+	{
+		loggingManager.logMsgProcessing(warning.code, lineNum + warning.lineNum);
+	}
+	const uint32_t warningLimit = loggingManager.getProcessingWarningLimit();
+	for (const auto& [code, tally] : chunkProcessor.deferredWarningTallies)
+	{
+		if (warningLimit != 0 && tally.count > warningLimit)
+		{
+			loggingManager.addSuppressedProcessingWarnings(code, { tally.count - warningLimit, lineNum + tally.firstLineNum, lineNum + tally.lastLineNum });
+		}
+	}
+	lineNum += chunkProcessor.lineNum;
+	phaseSamples.merge(chunkProcessor.phaseSamples);
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+	allocatingLineCount += chunkProcessor.allocatingLineCount;
+#endif
+
+	// counts of this processor are now those preceding the chunk
+	for (const DeferredFaceIndex& faceIndex : chunkProcessor.deferredFaceIndices)
+	{
+		if (faceIndex.excess > faceIndexElementCounts[faceIndex.element])
+		{
+			// collections past the chunk's closed ones are its still open one
+			if (faceIndex.collectionIndex < chunkProcessor.resultStore.size())
+			{
+				chunkProcessor.resultStore.invalidFaceIndexCounts[faceIndex.collectionIndex]++;
+			}
+			else
+			{
+				chunkProcessor.currentCollection.invalidFaceIndexCount++;
+			}
+		}
+	}
+	for (size_t element = 0; element < faceIndexElementCounts.size(); element++)
+	{
+		faceIndexElementCounts[element] += chunkProcessor.faceIndexElementCounts[element];
+	}
+
+	// before the chunk's collections, so closing them while streaming sees the chunk's libraries
+	materialLibraryPaths.insert(materialLibraryPaths.end(), chunkProcessor.materialLibraryPaths.begin(), chunkProcessor.materialLibraryPaths.end());
+
+	// first collection of a chunk holds the lines before its first "o"/"g" line,
+	// which belong to whichever collection was still open at the end of the previous chunk
+	const bool bChunkClosedFirstCollection = !chunkProcessor.resultStore.empty();
+	if (bChunkClosedFirstCollection)
+	{
+		PrimDataCollection leadingCollection{ std::string_view() };
+		chunkProcessor.resultStore.load(0, leadingCollection);
+		currentCollection.merge(leadingCollection);
+	}
+	else
+	{
+		currentCollection.merge(chunkProcessor.currentCollection);
+	}
+
+	if (settings.bCountUniqueVerts)
+	{
+		UniqueVertexTable& chunkVertexTable = bChunkClosedFirstCollection ? chunkProcessor.leadingVertexTable : chunkProcessor.uniqueVertexTable;
+		uniqueVertexTable.insertAll(chunkVertexTable);
+		// return the merged positions to the budget for the chunks still to merge
+		chunkVertexTable.reset();
+		getCurrentObject().uniqueVertCount = uint32_t(uniqueVertexTable.getUniqueCount());
+		getCurrentObject().uniqueVertCountIsUpperBound = uniqueVertexTable.isOverCap();
+	}
+
+	if (bChunkClosedFirstCollection)
+	{
+		if (onCollectionClosed)
+		{
+			for (size_t row = 1; row < chunkProcessor.resultStore.size(); row++)
+			{
+				closeCurrentCollection();
+				chunkProcessor.resultStore.load(row, currentCollection);
+			}
+			closeCurrentCollection();
+		}
+		else
+		{
+			// closed collections of the chunk are final, copy them column by column
+			closeCurrentCollection();
+			resultStore.appendRows(chunkProcessor.resultStore, 1);
+		}
+		currentCollection = std::move(chunkProcessor.currentCollection);
+
+		// positions of the collection still open at the end of the chunk
+		if (settings.bCountUniqueVerts)
 		{
-			getCurrentObject().addMaterial(lineProcessor.getValues().front());
+			uniqueVertexTable.swap(chunkProcessor.uniqueVertexTable);
 		}
 	}
-	file.close();
+}
+
+void FileProcessor::processFile()
+{
+	loggingManager.logMsgProcessing(LogPresetProcessing::ProcessingStart_log);
+	loggingManager.logMsgIo(LogPresetIo::InPathRead_log, filepath);
+	const auto start_time = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds* ioTime = settings.bCollectStats ? &stats.phases.io : nullptr;
+
+	InputFileReader file;
+	{
+		ScopedPhaseTimer ioTimer(ioTime);
+		file.open(filepath);
+	}
+	if (settings.bCollectStats)
+	{
+		std::error_code errorCode;
+		stats.byteCount = file.isMapped() ? file.getMappedData().size() : std::filesystem::file_size(filepath, errorCode);
+	}
 
-	if (!file.eof())
+	lineNum = 0;
+	// fail fast needs to see lines in order to stop early, topology needs every face index resolved when parsed
+	if (chunkWorkerPool != nullptr
+		&& !settings.bFailFast
+		&& !settings.bAnalyzeTopology
+		&& chunkWorkerPool->getThreadCount() > 1
+		&& file.getMappedData().size() >= minChunkedFileSize
+		)
+	{
+		processChunked(file.getMappedData());
+	}
+	else
+	{
+		processLinesForGrouping(file);
+	}
+	{
+		ScopedPhaseTimer ioTimer(ioTime);
+		file.close();
+	}
+
+	// the last collection is counted, free the positions for the other files of the run
+	uniqueVertexTable.reset();
+	leadingVertexTable.reset();
+
+	bReadFailed = file.hasFailed();
+	if (bReadFailed)
 	{
 		// failed before reaching end of file
 		if (settings.isMultiFile())
@@ -201,9 +841,55 @@ void FileProcessor::processFile()
 			loggingManager.logMsgIo(LogPresetIo::InFileReadFail_err, filepath);
 		}
 	}
+	if (settings.bAnalyzeTopology)
+	{
+		closeCollectionTopology(currentCollection);
+	}
+
+	// last collection is only closed by the end of the file
+	// a vertex is only known to be isolated once every face is read,
+	// libraries apply to the whole file, so unless streaming, materials used before their "mtllib" line are still resolved
+	if (onCollectionClosed)
+	{
+		if (settings.bAnalyzeTopology)
+		{
+			currentCollection.isolatedVertCount = countIsolatedVerts(currentCollection.vertCount, collectionFirstVertIndices.back());
+		}
+		if (loadMaterialLibraries())
+		{
+			currentCollection.resolveMaterials(materialLibraries);
+		}
+		onCollectionClosed(currentCollection);
+	}
+	else
+	{
+		resultStore.append(currentCollection);
+		if (settings.bAnalyzeTopology)
+		{
+			for (size_t row = 0; row < resultStore.size(); row++)
+			{
+				resultStore.isolatedVertCounts[row] = countIsolatedVerts(resultStore.vertCounts[row], collectionFirstVertIndices[row]);
+			}
+		}
+		if (loadMaterialLibraries())
+		{
+			resultStore.resolveMaterials(materialLibraries);
+		}
+	}
+
+	loggingManager.logProcessingWarningSummary();
+
+	const std::chrono::nanoseconds elapsedTime = std::chrono::steady_clock::now() - start_time;
+	if (settings.bCollectStats)
+	{
+		stats.lineCount = lineNum;
+		stats.totalTime += elapsedTime;
+		phaseSamples.extrapolateTo(stats.phases, lineNum);
+	}
+
 	// log elapsed time
 	loggingManager.logMsgProcessing(LogPresetProcessing::ProcessingEndStats_log,
-		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start_time),
+		std::chrono::duration_cast<std::chrono::milliseconds>(elapsedTime),
 		lineNum
 		);
 	loggingManager.logMsgProcessing(LogPresetProcessing::ProcessingEnd_log);
@@ -248,6 +934,12 @@ void ProgramArgParcer::ProcessValidationSettings(ProcessingSettings& settings)
 	setValidationBoolElem(settings.validations.containsNgons,         "-fng",   false);
 	setValidationBoolElem(settings.validations.containsMaterials,     "-mat",   true);
 	setValidationBoolElem(settings.validations.MissingName,           "-nn",    false);
+	setValidationBoolElem(settings.validations.containsInvalidFaceIndices, "-badidx", false);
+	setValidationBoolElem(settings.validations.containsDegenerateFaces,    "-degen",  false);
+	setValidationBoolElem(settings.validations.containsBoundaryEdges,      "-bedge",  false);
+	setValidationBoolElem(settings.validations.containsNonManifoldEdges,   "-nmedge", false);
+	setValidationBoolElem(settings.validations.containsIsolatedVerts,      "-iso",    false);
+	setValidationBoolElem(settings.validations.containsUndefinedMaterials, "-undefmat", false);
 
 	if (auto OptionalValue = getKargValue("-prefix"))
 	{
@@ -260,6 +952,11 @@ void ProgramArgParcer::ProcessValidationSettings(ProcessingSettings& settings)
 		settings.validations.nameSuffix.shouldCheck = true;
 		settings.validations.nameSuffix.substring = std::string(*OptionalValue);
 	}
+
+	if (getFloatArg(settings.validations.maxExtent.maxValue, "-ext"))
+	{
+		settings.validations.maxExtent.shouldCheck = true;
+	}
 }
 
 void ProgramArgParcer::setValidationBoolElem(ValidationBoolElem& elem, std::string_view key, bool defaultExpectedValue)
@@ -274,14 +971,22 @@ void ProgramArgParcer::setValidationBoolElem(ValidationBoolElem& elem, std::stri
 void ProgramArgParcer::ProcessBudgetSettings(ProcessingSettings& settings)
 {
 	setBudgetUint32Elem(settings.budgets.verts,      "-v");
+	setBudgetUint32Elem(settings.budgets.uniqueVerts, "-uniq");
 	setBudgetUint32Elem(settings.budgets.points,     "-p");
 	setBudgetUint32Elem(settings.budgets.lines,      "-l");
 	setBudgetUint32Elem(settings.budgets.faceTotals, "-f");
 	setBudgetUint32Elem(settings.budgets.faceTris,   "-ft");
 	setBudgetUint32Elem(settings.budgets.faceQuads,  "-fq");
 	setBudgetUint32Elem(settings.budgets.faceNgons,  "-fng");
+	setBudgetUint32Elem(settings.budgets.faceTriEquivalents, "-tris");
 	setBudgetUint32Elem(settings.budgets.materials,  "-mat");
+	setBudgetUint32Elem(settings.budgets.textures,   "-tex");
 	setBudgetUint32Elem(settings.budgets.groups,     "-g");
+
+	if (getFloatArg(settings.budgets.maxExtent.value, "-ext"))
+	{
+		settings.budgets.maxExtent.shouldCheck = true;
+	}
 }
 
 void ProgramArgParcer::setBudgetUint32Elem(BudgetUint32Elem& elem, const std::string_view key)
@@ -310,12 +1015,60 @@ void ProgramArgParcer::setBudgetUint32Elem(BudgetUint32Elem& elem, const std::st
 	}
 }
 
+bool ProgramArgParcer::getFloatArg(float& resultValue, const std::string_view key)
+{
+	if (auto OptionalValue = getKargValue(key))
+	{
+		std::string_view& argValue = *OptionalValue;
+		auto convertionResult = std::from_chars(argValue.data(), argValue.data() + argValue.size(), resultValue);
+		if (convertionResult.ec != std::errc() || convertionResult.ptr != argValue.data() + argValue.size() || resultValue < 0)
+		{
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::GenericInvaid_err, key);
+			return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+void ProgramArgParcer::ProcessThreadingSettings(ProcessingSettings& settings)
+{
+	setThreadCount(settings.parseThreadCount, "-threads");
+	setThreadCount(settings.fileJobCount,     "-jobs");
+}
+
+void ProgramArgParcer::setThreadCount(uint32_t& threadCount, const std::string_view key)
+{
+	if (auto OptionalValue = getKargValue(key))
+	{
+		uint32_t resultValue = 0;
+		std::string_view& argValue = *OptionalValue;
+		auto convertionErrStatus = std::from_chars(argValue.data(), argValue.data() + argValue.size(), resultValue).ec;
+		if (convertionErrStatus == std::errc() && resultValue != 0)
+		{
+			threadCount = resultValue;
+		}
+		else
+		{
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::GenericInvaid_warn, key, std::to_string(threadCount));
+		}
+	}
+}
+
+// .obj, or .obj.gz & .obj.zst if the build supports their compression
+static bool isObjFilePath(const std::filesystem::path& filepath)
+{
+	const CompressionFormat format = getCompressionFormat(filepath);
+	return (format == CompressionFormat::None || isCompressionSupported(format))
+		&& removeCompressionExtension(filepath).extension() == ".obj";
+}
+
 void ProgramArgParcer::getFilesFromDir(const std::filesystem::path& dirPath, std::vector<std::filesystem::path>& filepathCollection)
 {
 	for (auto const& entry : std::filesystem::directory_iterator(dirPath, std::filesystem::directory_options::skip_permission_denied))
 	{
 		if (std::filesystem::is_regular_file(entry)
-			&& entry.path().extension() == ".obj"
+			&& isObjFilePath(entry.path())
 			)
 		{
 			filepathCollection.push_back(entry.path());
@@ -389,7 +1142,7 @@ ProcessingSettings ProgramArgParcer::asSettings()
 		{
 			if (std::filesystem::is_regular_file(pathArg))
 			{
-				if (pathArg.extension() == ".obj")
+				if (isObjFilePath(pathArg))
 				{
 					settings.inputFilePaths.push_back(std::move(std::filesystem::path(pathArg)));
 				}
@@ -460,9 +1213,138 @@ ProcessingSettings ProgramArgParcer::asSettings()
 		case ProcessingMode::Budget: ProcessBudgetSettings(settings); break;
 	}
 
+	// performance
+	ProcessThreadingSettings(settings);
+
+	if (auto OptionalValue = getKargValue("-stream"))
+	{
+		if (settings.fileJobCount > 1)
+		{
+			// reports of concurrently processed files are output in input order, so can't be streamed
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::StreamIgnored_warn);
+		}
+		else
+		{
+			settings.bStreamReports = convertSvToBool(*OptionalValue, true);
+		}
+	}
+
+	if (auto OptionalValue = getKargValue("-stats"))
+	{
+		settings.bCollectStats = true;
+		// without a path, stats are written to the log
+		if (!OptionalValue->empty())
+		{
+			settings.statsFilePath = *OptionalValue;
+			if (!settings.statsFilePath.has_extension())
+			{
+				settings.statsFilePath += std::filesystem::path(".json");
+			}
+		}
+	}
+
+	if (auto OptionalValue = getKargValue("-bounds"))
+	{
+		settings.bComputeBounds = convertSvToBool(*OptionalValue, true);
+	}
+	// extent checks need the bounds
+	settings.bComputeBounds |= settings.validations.maxExtent.shouldCheck || settings.budgets.maxExtent.shouldCheck;
+
+	if (auto OptionalValue = getKargValue("-checkidx"))
+	{
+		settings.bCheckFaceIndices = convertSvToBool(*OptionalValue, true);
+	}
+	if (auto OptionalValue = getKargValue("-topo"))
+	{
+		settings.bAnalyzeTopology = convertSvToBool(*OptionalValue, true);
+	}
+	settings.bAnalyzeTopology |= settings.validations.containsDegenerateFaces.shouldCheck
+		|| settings.validations.containsBoundaryEdges.shouldCheck
+		|| settings.validations.containsNonManifoldEdges.shouldCheck
+		|| settings.validations.containsIsolatedVerts.shouldCheck;
+
+	settings.bCheckFaceIndices |= settings.validations.containsInvalidFaceIndices.shouldCheck || settings.bAnalyzeTopology;
+
+	if (auto OptionalValue = getKargValue("-unique"))
+	{
+		settings.bCountUniqueVerts = convertSvToBool(*OptionalValue, true);
+	}
+	if (getFloatArg(settings.weldEpsilon, "-weld"))
+	{
+		settings.bCountUniqueVerts = true;
+	}
+	if (auto OptionalValue = getKargValue("-uniquemem"))
+	{
+		uint32_t resultValue = 0;
+		auto convertionErrStatus = std::from_chars(OptionalValue->data(), OptionalValue->data() + OptionalValue->size(), resultValue).ec;
+		if (convertionErrStatus == std::errc() && resultValue != 0)
+		{
+			settings.uniqueVertMemoryCap = uint64_t(resultValue) << 20; // MiB
+		}
+		else
+		{
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::GenericInvaid_warn, "-uniquemem", std::to_string(settings.uniqueVertMemoryCap >> 20));
+		}
+	}
+	settings.bCountUniqueVerts |= bool(settings.budgets.uniqueVerts.shouldCheck);
+
+	if (auto OptionalValue = getKargValue("-mtl"))
+	{
+		settings.bResolveMaterials = convertSvToBool(*OptionalValue, true);
+	}
+	settings.bResolveMaterials |= settings.validations.containsUndefinedMaterials.shouldCheck || settings.budgets.textures.shouldCheck;
+
+	if (auto OptionalValue = getKargValue("-matusage"))
+	{
+		settings.bReportMaterialUsage = convertSvToBool(*OptionalValue, true);
+	}
+
+	if (auto OptionalValue = getKargValue("-maxwarnings"))
+	{
+		uint32_t resultValue = 0;
+		auto convertionErrStatus = std::from_chars(OptionalValue->data(), OptionalValue->data() + OptionalValue->size(), resultValue).ec;
+		if (convertionErrStatus == std::errc())
+		{
+			settings.processingWarningLimit = resultValue;
+		}
+		else
+		{
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::GenericInvaid_warn, "-maxwarnings", std::to_string(settings.processingWarningLimit));
+		}
+	}
+
+	if (getKargValue("-failfast"))
+	{
+		if (settings.mode == ProcessingMode::Budget && settings.grouping == DataCollectionGrouping::File)
+		{
+			settings.bFailFast = convertSvToBool(*getKargValue("-failfast"), true);
+		}
+		else
+		{
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::FailFastIgnored_warn);
+		}
+	}
+
 	// output
 	settings.logFilePath = getLogPath(false);
 
+	if (auto OptionalValue = getKargValue("-cache"))
+	{
+		if (settings.bResolveMaterials)
+		{
+			// cache entries only track the obj, edits to its libraries would go unnoticed
+			loggingManager.logMsgProgramArg(LogPresetProgramArg::CacheIgnored_warn);
+		}
+		else
+		{
+			settings.cacheDirPath = *OptionalValue;
+		}
+		if (auto OptionalHashValue = getKargValue("-cachehash"))
+		{
+			settings.bCacheHashContent = convertSvToBool(*OptionalHashValue, true);
+		}
+	}
+
 	if (auto OptionalValue = getKargValue("-csv"))
 	{
 		std::filesystem::path csvPath = *OptionalValue;
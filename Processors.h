@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <filesystem>
 #include <iostream>
 #include <string>
@@ -8,21 +11,39 @@
 #include <map>
 #include <optional>
 #include <chrono>
+#include <functional>
+#include <memory_resource>
 
 #include "Settings.h"
 #include "LogManager.h"
+#include "InputReaders.h"
+#include "LineScanner.h"
+#include "WorkerPool.h"
+#include "AllocationCounter.h"
+#include "ProcessingStats.h"
+#include "UniqueVertexTable.h"
+#include "MaterialLibrary.h"
+#include "FileArena.h"
 
 
 class LineProcessor
 {
 public:
-	std::string lineStr;
+	// view into the input reader's data, only valid until the next line is read
+	std::string_view line;
+	// ' ' in line, counted by the reader in the same vectorized pass that finds the line end, see findNewline()
+	uint32_t spaceCount = 0;
 
-	//std::string_view getLineType() const; // TODO: test if outputting enum would be faster
-	std::string_view getLineType() const;
+	LineType getLineType() const;
 
+	// values of the line, ex: face vertex count
 	uint32_t getValueCount() const;
-	std::vector<std::string_view> getValues() const;
+	// non allocating, values are views into line
+	LineValues getValues() const;
+	// everything after the keyword, trimmed of spaces & tabs, ex: names containing spaces
+	std::string_view getValuesText() const;
+	// parses the x y z values of a vertex line, false if missing or malformed
+	bool getVertexPosition(std::array<float, 3>& position) const;
 };
 
 class FileProcessor
@@ -30,16 +51,162 @@ class FileProcessor
 protected:
 	const std::filesystem::path& filepath;
 	LogManager& loggingManager;
+	WorkerPool* chunkWorkerPool;
+	// backs the per file containers below & resultStore, see FileArena
+	// unique vertex tables, materials & currentCollection stay on the heap, they are swapped or moved between processors
+	std::pmr::memory_resource* const memoryResource;
 	uint64_t lineNum = 0;
+	// set when reading stopped before eof because the results could no longer change
+	bool bStoppedEarly = false;
+	bool bReadFailed = false;
+
+	// how often -failfast re-evaluates budgets, power of 2
+	static constexpr uint64_t failFastCheckInterval = 4096;
+
+	static constexpr size_t minChunkSize = 4 << 20; // 4 MiB
+
+	// chunk processors defer warnings so they can be logged in order with file line numbers
+	struct DeferredWarning
+	{
+		LogPresetProcessing code;
+		uint64_t lineNum;
+	};
+	bool bDeferWarnings = false;
+	std::pmr::vector<DeferredWarning> deferredWarnings;
+
+	// v, vt & vn lines seen so far, face indices are resolved against these
+	enum FaceIndexElement : uint8_t { FaceIndexPosition, FaceIndexUv, FaceIndexNormal };
+	std::array<uint64_t, 3> faceIndexElementCounts = {};
+	// chunk processors don't know how many elements preceding chunks define,
+	// so indices past their own counts are resolved by mergeChunk() once the preceding chunks are merged
+	struct DeferredFaceIndex
+	{
+		uint32_t collectionIndex;
+		FaceIndexElement element;
+		// elements missing from this chunk's counts for the index to be valid
+		uint64_t excess;
+	};
+	std::pmr::vector<DeferredFaceIndex> deferredFaceIndices;
+
+	// topology of the current collection, see settings.bAnalyzeTopology
+	// position indices of the face being parsed, 1 based
+	std::pmr::vector<uint32_t> faceVertexIndices;
+	// edges of the current collection's faces, lower vertex index in the high bits
+	std::pmr::vector<uint64_t> topologyEdgeKeys;
+	// bit per vertex of the file, set once used by a face
+	std::pmr::vector<uint64_t> referencedVertBits;
+	// index of the first vertex of each collection, vertices of a collection are contiguous
+	std::pmr::vector<uint32_t> collectionFirstVertIndices;
+
+	// only set when no run wide budget was given, see uniqueVertexMemoryBudget
+	std::unique_ptr<UniqueVertexMemoryBudget> ownUniqueVertexMemoryBudget;
+	// settings.uniqueVertMemoryCap, shared with the chunk processors & other files of the run
+	UniqueVertexMemoryBudget& uniqueVertexMemoryBudget;
+	// positions of the current collection, see settings.bCountUniqueVerts
+	UniqueVertexTable uniqueVertexTable;
+	// chunk processors keep the positions of their first collection, which continues the last one of the previous chunk
+	UniqueVertexTable leadingVertexTable;
+	// "mtllib" files in file order, see settings.bResolveMaterials
+	std::vector<std::filesystem::path> materialLibraryPaths;
+	// loaded libraries of materialLibraryPaths so far, including those that failed to load
+	std::vector<std::shared_ptr<const MaterialLibrary>> materialLibraries;
+	// shared by all files of the run, null = materials are not resolved
+	MaterialLibraryCache* materialLibraryCache = nullptr;
+
+	// all occurrences per code, only those within the processing warning limit are deferred so pathological chunks stay bounded
+	std::pmr::map<LogPresetProcessing, ProcessingWarningTally> deferredWarningTallies;
+
+	// number of times results grew (collection added, new material, warning logged),
+	// lines that grow the results are the only ones allowed to allocate
+	uint64_t resultGrowthCount = 0;
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+	// lines that allocated without growing the results, see ObjAnalyzerBench -check
+	uint64_t allocatingLineCount = 0;
+#endif
+
+	// only collected with settings.bCollectStats
+	ParsePhaseSamples phaseSamples;
+	FileStats stats;
+
+	// called with each finished collection when streaming, see setCollectionClosedCallback()
+	std::function<void(const PrimDataCollection&)> onCollectionClosed;
+
+	// collection the parsed lines are added to, see resultStore for the closed ones
+	PrimDataCollection currentCollection;
+
+	void addCollection(std::string_view name);
+	// when streaming, hand current collection to onCollectionClosed, else append it to resultStore
+	// the caller then starts the next collection in currentCollection
+	void closeCurrentCollection();
+	void logProcessingWarning(LogPresetProcessing code);
+	// parse v, v/vt, v//vn & v/vt/vn tokens of a face line & count invalid references, see settings.bCheckFaceIndices
+	void checkFaceIndices(std::string_view line);
+	// resolved 1 based index, 0 if invalid or only resolvable by mergeChunk()
+	uint32_t checkFaceIndex(FaceIndexElement element, int64_t index);
+	// add edges & referenced vertices of faceVertexIndices
+	void addFaceTopology(PrimDataCollection& collection);
+	// count boundary & non manifold edges of the current collection's edges
+	void closeCollectionTopology(PrimDataCollection& collection);
+	// vertices of collection not referenced by any face so far
+	uint32_t countIsolatedVerts(uint32_t vertCount, uint32_t firstVertIndex) const;
+	void addUniqueVertex(PrimDataCollection& collection, const std::array<float, 3>& position);
+	// called when the current collection is closed
+	void resetUniqueVertexTable();
+	// load libraries referenced so far, false if materials are not resolved
+	bool loadMaterialLibraries();
+
+	// parse loop is specialized per grouping, so grouping checks are resolved at compile time
+	template<DataCollectionGrouping grouping>
+	void processLine(const LineProcessor& lineProcessor, const LineType lineType);
+	// processLine with its phases timed into phaseSamples
+	template<DataCollectionGrouping grouping>
+	void processLineSampled(const LineProcessor& lineProcessor);
+	// Reader: InputFileReader or InputChunkReader
+	template<DataCollectionGrouping grouping, typename Reader>
+	void processLines(Reader& reader);
+	// dispatch to processLines specialization of settings.grouping
+	template<typename Reader>
+	void processLinesForGrouping(Reader& reader);
+
+	// split mapped file at newlines & process chunks on chunkWorkerPool
+	void processChunked(std::string_view fileData);
+	// fold results of the next chunk in file order into this processor
+	void mergeChunk(FileProcessor& chunkProcessor);
 
 public:
+	// files smaller than this are not worth splitting into chunks
+	static constexpr size_t minChunkedFileSize = 32 << 20; // 32 MiB
+
 	const ProcessingSettings& settings;
-	std::vector<PrimDataCollection> PrimDataCollections;
+	// computed once from settings instead of per line
+	const LineTypeMask relevantLineTypes;
+	// closed collections, all collections of the file once processed unless streaming
+	PrimDataStore resultStore;
 
-	FileProcessor(const std::filesystem::path& filepath, const ProcessingSettings& settings, LogManager& loggingManager);
+	// chunkWorkerPool is optional, large files are split across its threads when provided
+	// arena is optional, it must outlive the processor & is typically released & reused for the next file
+	// uniqueVertexMemoryBudget is optional, it must outlive the processor & is shared by all processors of the run,
+	// else the processor gets its own budget of settings.uniqueVertMemoryCap
+	FileProcessor(const std::filesystem::path& filepath, const ProcessingSettings& settings, LogManager& loggingManager, WorkerPool* chunkWorkerPool = nullptr,
+		FileArena* arena = nullptr, UniqueVertexMemoryBudget* uniqueVertexMemoryBudget = nullptr);
 
 	const std::filesystem::path& getFilepath() const;
 	PrimDataCollection& getCurrentObject();
+	bool hasStoppedEarly() const;
+	bool hasReadFailed() const;
+	// filled by processFile() when settings.bCollectStats, output phases are added by the caller
+	FileStats& getStats();
+#ifdef OBJANALYZER_COUNT_ALLOCATIONS
+	// lines that allocated although they didn't grow the results, including those of merged chunks, should be 0
+	uint64_t getAllocatingLineCount() const;
+#endif
+
+	// stream results: each collection is handed to callback as soon as the next "o"/"g" line closes it
+	// & then reused, so resultStore stays empty
+	void setCollectionClosedCallback(std::function<void(const PrimDataCollection&)> callback);
+	bool isStreaming() const;
+	// resolve materials against the "mtllib" libraries loaded through cache, see settings.bResolveMaterials
+	void setMaterialLibraryCache(MaterialLibraryCache* cache);
 
 	void processFile();
 };
@@ -48,7 +215,7 @@ class ProgramArgParcer
 {
 	LogManager& loggingManager;
 
-	const std::map<const std::string_view, bool>& svToBoolTable
+	const std::map<const std::string_view, bool> svToBoolTable
 	{
 		{ "true" , true },
 		{ "t"    , true },
@@ -92,6 +259,11 @@ class ProgramArgParcer
 
 	void setValidationBoolElem(ValidationBoolElem& elem, std::string_view key, bool defaultExpectedValue);
 	void setBudgetUint32Elem(BudgetUint32Elem& elem, const std::string_view key);
+	// shared by the budget & validation extent limits
+	bool getFloatArg(float& resultValue, const std::string_view key);
+
+	void ProcessThreadingSettings(ProcessingSettings& settings);
+	void setThreadCount(uint32_t& threadCount, const std::string_view key);
 	
 	void getFilesFromDir(const std::filesystem::path& dirPath, std::vector<std::filesystem::path>& filepathCollection);
 
@@ -0,0 +1,259 @@
+#include "ResultCache.h"
+
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+
+#include "InputReaders.h"
+
+template<typename T>
+static void writePod(std::ostream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void readPod(std::istream& stream, T& value)
+{
+	stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+static inline uint64_t mixHashWord(uint64_t hash, const char* data)
+{
+	uint64_t word;
+	std::memcpy(&word, data, 8);
+	return std::rotl(hash ^ (word * 0x9E3779B97F4A7C15ull), 27) * 0xFF51AFD7ED558CCDull;
+}
+
+// 8 bytes per step, tail bytes are only handled at the end of the data
+static uint64_t hashBytes(uint64_t hash, const char* data, size_t size)
+{
+	const char* dataEnd = data + size;
+	for (; dataEnd - data >= 8; data += 8)
+	{
+		hash = mixHashWord(hash, data);
+	}
+
+	char tail[8] = {};
+	if (data != dataEnd)
+	{
+		std::memcpy(tail, data, dataEnd - data);
+	}
+	hash = mixHashWord(hash, tail);
+	return hash ^ (hash >> 29);
+}
+
+// --------------------------------
+ResultCache::ResultCache(const std::filesystem::path& cacheDirPath, bool hashContent)
+	: cacheDirPath(cacheDirPath)
+	, bHashContent(hashContent)
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(cacheDirPath, errorCode);
+};
+
+uint64_t ResultCache::hashFileContent(const std::filesystem::path& filepath)
+{
+	constexpr uint64_t hashSeed = 0xCBF29CE484222325ull;
+
+	// compressed files are hashed as stored
+	InputFileReader mappedFile(filepath, false);
+	if (mappedFile.isMapped())
+	{
+		const std::string_view data = mappedFile.getMappedData();
+		return hashBytes(hashSeed, data.data(), data.size());
+	}
+
+	std::ifstream file(filepath, std::ios::binary);
+	if (!file)
+	{
+		return 0;
+	}
+	// block size must stay a multiple of 8 to match the mapped result
+	std::vector<char> buffer(1 << 20);
+	uint64_t hash = hashSeed;
+	while (file.read(buffer.data(), std::streamsize(buffer.size())) || file.gcount() != 0)
+	{
+		const size_t readSize = size_t(file.gcount());
+		if (readSize == buffer.size())
+		{
+			for (size_t i = 0; i < readSize; i += 8)
+			{
+				hash = mixHashWord(hash, buffer.data() + i);
+			}
+		}
+		else
+		{
+			// last block
+			return hashBytes(hash, buffer.data(), readSize);
+		}
+	}
+	return hashBytes(hash, nullptr, 0);
+};
+
+bool ResultCache::makeKey(const std::filesystem::path& filepath, const ProcessingSettings& settings, EntryKey& key) const
+{
+	std::error_code errorCode;
+	const std::filesystem::path absolutePath = std::filesystem::absolute(filepath, errorCode);
+	if (errorCode)
+	{
+		return false;
+	}
+	key.path = absolutePath.generic_string();
+
+	key.fileSize = std::filesystem::file_size(filepath, errorCode);
+	if (errorCode)
+	{
+		return false;
+	}
+
+	if (bHashContent)
+	{
+		// content hash replaces modification time, so touched but unchanged files still hit
+		key.contentHash = hashFileContent(filepath);
+	}
+	else
+	{
+		key.modificationTime = int64_t(std::filesystem::last_write_time(filepath, errorCode).time_since_epoch().count());
+		if (errorCode)
+		{
+			return false;
+		}
+	}
+
+	key.grouping = uint8_t(settings.grouping);
+	key.relevantLineTypes = settings.getRelevantLineTypes();
+	key.analysisFlags = settings.getAnalysisFlags();
+	if (settings.bCountUniqueVerts)
+	{
+		key.weldEpsilon = settings.weldEpsilon;
+		key.uniqueVertMemoryCap = settings.uniqueVertMemoryCap;
+	}
+	return true;
+};
+
+std::filesystem::path ResultCache::getEntryPath(const EntryKey& key) const
+{
+	return cacheDirPath / std::format("{:016x}-{}-{:04x}-{:02x}.cache",
+		std::hash<std::string>{}(key.path),
+		key.grouping,
+		key.relevantLineTypes,
+		key.analysisFlags
+	);
+};
+
+bool ResultCache::load(const EntryKey& key, PrimDataStore& collections)
+{
+	std::ifstream entryFile(getEntryPath(key), std::ios::binary);
+	if (!entryFile)
+	{
+		missCount++;
+		return false;
+	}
+
+	char magic[sizeof(entryMagic)] = {};
+	uint32_t version = 0;
+	entryFile.read(magic, sizeof(magic));
+	readPod(entryFile, version);
+
+	EntryKey storedKey;
+	uint32_t pathSize = 0;
+	readPod(entryFile, pathSize);
+	if (!entryFile
+		|| std::memcmp(magic, entryMagic, sizeof(entryMagic)) != 0
+		|| version != entryVersion
+		|| pathSize != key.path.size()
+		)
+	{
+		missCount++;
+		return false;
+	}
+	storedKey.path.resize(pathSize);
+	entryFile.read(storedKey.path.data(), std::streamsize(pathSize));
+	readPod(entryFile, storedKey.fileSize);
+	readPod(entryFile, storedKey.modificationTime);
+	readPod(entryFile, storedKey.contentHash);
+	readPod(entryFile, storedKey.grouping);
+	readPod(entryFile, storedKey.relevantLineTypes);
+	readPod(entryFile, storedKey.analysisFlags);
+	readPod(entryFile, storedKey.weldEpsilon);
+	readPod(entryFile, storedKey.uniqueVertMemoryCap);
+
+	if (!entryFile || !(storedKey == key))
+	{
+		missCount++;
+		return false;
+	}
+
+	// read in place so rows end up in the memory resource of collections
+	if (!collections.readFrom(entryFile))
+	{
+		collections.clear();
+		missCount++;
+		return false;
+	}
+
+	hitCount++;
+	return true;
+};
+
+bool ResultCache::store(const EntryKey& key, const PrimDataStore& collections)
+{
+	// write to a temp file first so concurrent readers never see partial entries
+	// several processes may share the cache dir, thread ids repeat across processes so the name is
+	// a random per process token + a per process counter
+	static const uint64_t processToken = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}()
+		^ uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+	static std::atomic<uint64_t> tempFileCount = 0;
+	const std::filesystem::path entryPath = getEntryPath(key);
+	std::filesystem::path tempPath = entryPath;
+	tempPath += std::format(".{:016x}-{:x}.tmp", processToken, tempFileCount++);
+	{
+		std::ofstream entryFile(tempPath, std::ios::binary | std::ios::trunc);
+		entryFile.write(entryMagic, sizeof(entryMagic));
+		writePod(entryFile, entryVersion);
+
+		writePod(entryFile, uint32_t(key.path.size()));
+		entryFile.write(key.path.data(), std::streamsize(key.path.size()));
+		writePod(entryFile, key.fileSize);
+		writePod(entryFile, key.modificationTime);
+		writePod(entryFile, key.contentHash);
+		writePod(entryFile, key.grouping);
+		writePod(entryFile, key.relevantLineTypes);
+		writePod(entryFile, key.analysisFlags);
+		writePod(entryFile, key.weldEpsilon);
+		writePod(entryFile, key.uniqueVertMemoryCap);
+
+		collections.writeTo(entryFile);
+
+		entryFile.close();
+		if (!entryFile)
+		{
+			std::error_code errorCode;
+			std::filesystem::remove(tempPath, errorCode);
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempPath, entryPath, errorCode);
+	if (errorCode)
+	{
+		std::filesystem::remove(tempPath, errorCode);
+		return false;
+	}
+	return true;
+};
+
+uint64_t ResultCache::getHitCount() const
+{
+	return hitCount;
+};
+
+uint64_t ResultCache::getMissCount() const
+{
+	return missCount;
+};
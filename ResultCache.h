@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "DataCollection.h"
+#include "Settings.h"
+
+// on disk cache of processing results, one entry file per input file & result affecting settings
+// entries are keyed by path + size + modification time,
+// or path + size + content hash if content hashing is enabled
+class ResultCache
+{
+	static constexpr char entryMagic[8] = { 'O', 'B', 'J', 'A', 'C', 'A', 'C', 'H' };
+	static constexpr uint32_t entryVersion = 10;
+
+public:
+	// identifies the state of an input file an entry was created from
+	struct EntryKey
+	{
+		std::string path;
+		uint64_t fileSize = 0;
+		int64_t modificationTime = 0;
+		uint64_t contentHash = 0;
+		uint8_t grouping = 0;
+		LineTypeMask relevantLineTypes = 0;
+		uint8_t analysisFlags = 0;
+		// unique vertex parameters, 0 unless the analysis is enabled
+		float weldEpsilon = 0;
+		uint64_t uniqueVertMemoryCap = 0;
+
+		bool operator==(const EntryKey&) const = default;
+	};
+
+private:
+	const std::filesystem::path cacheDirPath;
+	const bool bHashContent;
+
+	std::atomic<uint64_t> hitCount = 0;
+	std::atomic<uint64_t> missCount = 0;
+
+	std::filesystem::path getEntryPath(const EntryKey& key) const;
+
+public:
+	ResultCache(const std::filesystem::path& cacheDirPath, bool hashContent);
+
+	// stat (& hash if enabled) input file, make key once & reuse it for load & store
+	// returns false if file can't be accessed
+	bool makeKey(const std::filesystem::path& filepath, const ProcessingSettings& settings, EntryKey& key) const;
+
+	// fills collections & returns true on hit, collections is left empty on a miss
+	bool load(const EntryKey& key, PrimDataStore& collections);
+	// returns false if entry could not be written
+	bool store(const EntryKey& key, const PrimDataStore& collections);
+
+	uint64_t getHitCount() const;
+	uint64_t getMissCount() const;
+
+	// fast non cryptographic hash of the entire file, 0 if unreadable
+	static uint64_t hashFileContent(const std::filesystem::path& filepath);
+};
@@ -1,5 +1,30 @@
 #include "Settings.h"
 
+bool BudgetSettings::isExceededByAll(const PrimDataCollection& asset) const
+{
+	bool isAnyChecked = false;
+	auto isExceeded = [&isAnyChecked](const auto& budgetElem, const auto statValue)
+		{
+			isAnyChecked |= bool(budgetElem.shouldCheck);
+			return !budgetElem.shouldCheck || statValue > budgetElem.value;
+		};
+
+	return isExceeded(verts,      asset.vertCount)
+		&& isExceeded(uniqueVerts, asset.uniqueVertCount)
+		&& isExceeded(points,     asset.pointCount)
+		&& isExceeded(lines,      asset.lineCount)
+		&& isExceeded(faceTotals, asset.faceTotalCount)
+		&& isExceeded(faceTris,   asset.faceTriCount)
+		&& isExceeded(faceQuads,  asset.faceQuadCount)
+		&& isExceeded(faceNgons,  asset.faceNgonCount)
+		&& isExceeded(faceTriEquivalents, asset.faceTriEquivalentCount)
+		&& isExceeded(materials,  uint32_t(asset.getMaterialCount()))
+		&& isExceeded(textures,   uint32_t(asset.getTextureCount()))
+		&& isExceeded(groups,     asset.subgroupCount)
+		&& isExceeded(maxExtent,  asset.getMaxExtent())
+		&& isAnyChecked;
+};
+
 bool ProcessingSettings::isMultiFile() const
 {
 	return bool(inputFilePaths.size() <= 2);
@@ -7,6 +32,11 @@ bool ProcessingSettings::isMultiFile() const
 
 bool ProcessingSettings::areVertsRelevent() const
 {
+	if (bComputeBounds || bCheckFaceIndices || bCountUniqueVerts)
+	{
+		return true;
+	}
+
 	switch (mode)
 	{
 	case ProcessingMode::Validate:
@@ -53,6 +83,11 @@ bool ProcessingSettings::areLinesRelevent() const
 
 bool ProcessingSettings::areFacesRelevent() const
 {
+	if (bCheckFaceIndices)
+	{
+		return true;
+	}
+
 	switch (mode)
 	{
 	case ProcessingMode::Validate:
@@ -66,6 +101,7 @@ bool ProcessingSettings::areFacesRelevent() const
 			|| budgets.faceTris.shouldCheck
 			|| budgets.faceQuads.shouldCheck
 			|| budgets.faceNgons.shouldCheck
+			|| budgets.faceTriEquivalents.shouldCheck
 			;
 	case ProcessingMode::Overview:
 		return true;
@@ -75,6 +111,11 @@ bool ProcessingSettings::areFacesRelevent() const
 
 bool ProcessingSettings::areMaterialsRelevent() const
 {
+	if (bResolveMaterials || bReportMaterialUsage)
+	{
+		return true;
+	}
+
 	switch (mode)
 	{
 	case ProcessingMode::Validate:
@@ -99,4 +140,45 @@ bool ProcessingSettings::areSubGroupsRelevent() const
 		return true;
 	}
 	return true;
+};
+
+uint8_t ProcessingSettings::getAnalysisFlags() const
+{
+	uint8_t flags = 0;
+	if (bComputeBounds)    { flags |= AnalysisBounds; }
+	if (bCheckFaceIndices) { flags |= AnalysisFaceIndices; }
+	if (bCountUniqueVerts) { flags |= AnalysisUniqueVerts; }
+	if (bAnalyzeTopology)  { flags |= AnalysisTopology; }
+	if (bResolveMaterials) { flags |= AnalysisMaterials; }
+	return flags;
+};
+
+LineTypeMask ProcessingSettings::getRelevantLineTypes() const
+{
+	LineTypeMask mask = 0;
+	if (areVertsRelevent())
+	{
+		mask |= lineTypeBit(LineType::Vertex) | lineTypeBit(LineType::VertexNormal) | lineTypeBit(LineType::VertexUv);
+	}
+	if (arePointsRelevent())    { mask |= lineTypeBit(LineType::Point); }
+	if (areLinesRelevent())     { mask |= lineTypeBit(LineType::Line); }
+	if (areFacesRelevent())     { mask |= lineTypeBit(LineType::Face); }
+	if (areMaterialsRelevent()) { mask |= lineTypeBit(LineType::UseMaterial); }
+	if (bResolveMaterials)      { mask |= lineTypeBit(LineType::MaterialLibrary); }
+
+	// container lines either start a new collection or count as sub group
+	switch (grouping)
+	{
+	case DataCollectionGrouping::File:
+		if (areSubGroupsRelevent()) { mask |= lineTypeBit(LineType::Object); }
+		break;
+	case DataCollectionGrouping::Object:
+		mask |= lineTypeBit(LineType::Object);
+		if (areSubGroupsRelevent()) { mask |= lineTypeBit(LineType::Group); }
+		break;
+	case DataCollectionGrouping::Vertexgroup:
+		mask |= lineTypeBit(LineType::Group);
+		break;
+	}
+	return mask;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "DataCollection.h"
+#include "LineScanner.h"
 
 struct ValidationBoolElem
 {
@@ -21,6 +22,14 @@ struct ValidationStringElem
 	std::string substring;
 };
 
+struct ValidationFloatElem
+{
+	uint8_t shouldCheck : 1 = 0;
+	// leftover bits: 7
+	// inclusive upper limit
+	float maxValue = 0;
+};
+
 struct ValidationSettings
 {
 	ValidationBoolElem containsVerts;
@@ -35,9 +44,17 @@ struct ValidationSettings
 	ValidationBoolElem containsNgons;
 	ValidationBoolElem containsMaterials;
 	ValidationBoolElem MissingName;
+	ValidationBoolElem containsInvalidFaceIndices;
+	ValidationBoolElem containsDegenerateFaces;
+	ValidationBoolElem containsBoundaryEdges;
+	ValidationBoolElem containsNonManifoldEdges;
+	ValidationBoolElem containsIsolatedVerts;
+	ValidationBoolElem containsUndefinedMaterials;
 
 	ValidationStringElem namePrefix;
 	ValidationStringElem nameSuffix;
+
+	ValidationFloatElem maxExtent;
 };
 
 struct BudgetUint32Elem
@@ -47,16 +64,30 @@ struct BudgetUint32Elem
 	uint32_t value : 31 = 0;
 };
 
+struct BudgetFloatElem
+{
+	uint8_t shouldCheck : 1 = 0;
+	// leftover bits: 7
+	float value = 0;
+};
+
 struct BudgetSettings {
 	BudgetUint32Elem verts;
+	BudgetUint32Elem uniqueVerts;
 	BudgetUint32Elem points;
 	BudgetUint32Elem lines;
 	BudgetUint32Elem faceTotals;
 	BudgetUint32Elem faceTris;
 	BudgetUint32Elem faceQuads;
 	BudgetUint32Elem faceNgons;
+	BudgetUint32Elem faceTriEquivalents;
 	BudgetUint32Elem materials;
+	BudgetUint32Elem textures;
 	BudgetUint32Elem groups;
+	BudgetFloatElem maxExtent;
+
+	// true if at least one budget is checked & every checked budget is exceeded by asset
+	bool isExceededByAll(const PrimDataCollection& asset) const;
 };
 
 enum class DataCollectionGrouping : uint8_t
@@ -73,6 +104,24 @@ enum class ProcessingMode : uint8_t
 	Budget
 };
 
+// optional analyses that change the results, bit per analysis
+enum AnalysisFlags : uint8_t
+{
+	AnalysisBounds      = 1 << 0,
+	AnalysisFaceIndices = 1 << 1,
+	AnalysisUniqueVerts = 1 << 2,
+	AnalysisTopology    = 1 << 3,
+	AnalysisMaterials   = 1 << 4,
+};
+
+// bit per LineType
+using LineTypeMask = uint16_t;
+
+constexpr LineTypeMask lineTypeBit(LineType type)
+{
+	return LineTypeMask(1u << uint8_t(type));
+}
+
 struct ProcessingSettings
 {
 	ValidationSettings validations;
@@ -83,8 +132,46 @@ struct ProcessingSettings
 
 	std::filesystem::path csvFilePath;
 	std::filesystem::path logFilePath;
+	// result cache directory, empty = no caching
+	std::filesystem::path cacheDirPath;
+	// validate cache entries by content hash instead of modification time
+	bool bCacheHashContent = false;
 	std::vector<std::filesystem::path> inputFilePaths;
 
+	// threads used to parse chunks of a single large file, 1 = serial
+	uint32_t parseThreadCount = 1;
+	// files processed concurrently, 1 = serial
+	uint32_t fileJobCount = 1;
+
+	// stop reading a file once all budgets have failed (budget mode, file grouping only)
+	bool bFailFast = false;
+	// output each collection as soon as it is closed instead of once the file is processed
+	bool bStreamReports = false;
+	// per phase timings & throughput, written as json to statsFilePath or the log if empty
+	bool bCollectStats = false;
+	std::filesystem::path statsFilePath;
+	// parse vertex positions for bounds, extent & centroid, implied by extent checks
+	bool bComputeBounds = false;
+	// resolve face v/vt/vn indices against the elements defined so far, implied by the invalid index validation
+	bool bCheckFaceIndices = false;
+	// degenerate faces, boundary & non manifold edges, isolated vertices, implied by their validations
+	// needs resolved face indices, so implies bCheckFaceIndices & disables chunked parsing
+	bool bAnalyzeTopology = false;
+	// count distinct vertex positions per collection, implied by the unique vertex budget
+	bool bCountUniqueVerts = false;
+	// 0 = exact positions, else positions in the same grid cell of this size are the same vertex
+	float weldEpsilon = 0;
+	// shared by all unique vertex tables of the run, counts become upper bounds once reached
+	uint64_t uniqueVertMemoryCap = uint64_t(2048) << 20;
+	// load "mtllib" libraries to count texture maps & undefined materials, implied by their validation & budget
+	// libraries can change without their obj, so results are not cached
+	bool bResolveMaterials = false;
+	// number of reported collections using each material, listed once all files are output
+	bool bReportMaterialUsage = false;
+
+	// occurrences of each processing warning shown per file before only counting them, 0 = unlimited
+	uint32_t processingWarningLimit = 10;
+
 	bool isMultiFile() const;
 
 	bool areVertsRelevent() const;
@@ -93,4 +180,10 @@ struct ProcessingSettings
 	bool areFacesRelevent() const;
 	bool areMaterialsRelevent() const;
 	bool areSubGroupsRelevent() const;
+
+	// AnalysisFlags of enabled analyses
+	uint8_t getAnalysisFlags() const;
+
+	// mask of line types affecting the results, based on the relevance checks above & grouping
+	LineTypeMask getRelevantLineTypes() const;
 };
\ No newline at end of file
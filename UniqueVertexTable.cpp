@@ -0,0 +1,183 @@
+#include "UniqueVertexTable.h"
+
+UniqueVertexMemoryBudget::UniqueVertexMemoryBudget(uint64_t capacity)
+	: capacity(capacity)
+{
+};
+
+bool UniqueVertexMemoryBudget::tryReserve(uint64_t size)
+{
+	uint64_t currentSize = reservedSize.load(std::memory_order_relaxed);
+	do
+	{
+		if (size > capacity - currentSize)
+		{
+			return false;
+		}
+	} while (!reservedSize.compare_exchange_weak(currentSize, currentSize + size, std::memory_order_relaxed));
+	return true;
+};
+
+void UniqueVertexMemoryBudget::release(uint64_t size)
+{
+	reservedSize.fetch_sub(size, std::memory_order_relaxed);
+};
+
+// --------------------------------
+UniqueVertexTable::UniqueVertexTable(float weldEpsilon, UniqueVertexMemoryBudget& memoryBudget)
+	: weldEpsilon(weldEpsilon)
+	, memoryBudget(memoryBudget)
+{
+};
+
+UniqueVertexTable::~UniqueVertexTable()
+{
+	memoryBudget.release(reservedSize);
+};
+
+bool UniqueVertexTable::grow()
+{
+	const size_t newSlotCount = slots.empty() ? initialSlotCount : slots.size() * 2;
+	const uint64_t newSize = newSlotCount * bytesPerSlot;
+	if (newSlotCount > (uint64_t(1) << 32) || !memoryBudget.tryReserve(newSize - reservedSize))
+	{
+		return false;
+	}
+	reservedSize = newSize;
+
+	std::vector<uint64_t> newSlots(newSlotCount, 0);
+	const size_t slotMask = newSlotCount - 1;
+	for (size_t i = 0; i < keysX.size(); i++)
+	{
+		const uint64_t hash = hashKey(keysX[i], keysY[i], keysZ[i]);
+		size_t slotIndex = hash & slotMask;
+		while (newSlots[slotIndex] != 0)
+		{
+			slotIndex = (slotIndex + 1) & slotMask;
+		}
+		newSlots[slotIndex] = (hash & 0xFFFFFFFF00000000ull) | (i + 1);
+	}
+	slots = std::move(newSlots);
+
+	// reserve up front so the coordinate arrays stay within the cap instead of doubling past it
+	growThreshold = newSlotCount / 4 * 3;
+	keysX.reserve(growThreshold);
+	keysY.reserve(growThreshold);
+	keysZ.reserve(growThreshold);
+	return true;
+};
+
+void UniqueVertexTable::insertKey(uint64_t x, uint64_t y, uint64_t z)
+{
+	if (slots.empty() && !bOverCap && !grow())
+	{
+		bOverCap = true;
+	}
+	if (slots.empty())
+	{
+		// cap too small for even the initial slots
+		unstoredCount++;
+		return;
+	}
+
+	const uint64_t hash = hashKey(x, y, z);
+	const uint64_t tag = hash & 0xFFFFFFFF00000000ull;
+	size_t slotMask = slots.size() - 1;
+	size_t slotIndex = hash & slotMask;
+	while (slots[slotIndex] != 0)
+	{
+		const uint64_t slot = slots[slotIndex];
+		if ((slot & 0xFFFFFFFF00000000ull) == tag)
+		{
+			const size_t entryIndex = (slot & 0xFFFFFFFF) - 1;
+			if (keysX[entryIndex] == x && keysY[entryIndex] == y && keysZ[entryIndex] == z)
+			{
+				return;
+			}
+		}
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+
+	// only grow for new positions, so duplicates never allocate
+	if (keysX.size() >= growThreshold)
+	{
+		if (bOverCap || !grow())
+		{
+			// full & not allowed to grow, later duplicates of this position are counted again
+			bOverCap = true;
+			unstoredCount++;
+			return;
+		}
+		slotMask = slots.size() - 1;
+		slotIndex = hash & slotMask;
+		while (slots[slotIndex] != 0)
+		{
+			slotIndex = (slotIndex + 1) & slotMask;
+		}
+	}
+	slots[slotIndex] = tag | (keysX.size() + 1);
+	keysX.push_back(x);
+	keysY.push_back(y);
+	keysZ.push_back(z);
+};
+
+void UniqueVertexTable::insertAll(const UniqueVertexTable& other)
+{
+	for (size_t i = 0; i < other.keysX.size(); i++)
+	{
+		insertKey(other.keysX[i], other.keysY[i], other.keysZ[i]);
+	}
+	unstoredCount += other.unstoredCount;
+	bOverCap |= other.bOverCap;
+};
+
+uint64_t UniqueVertexTable::getUniqueCount() const
+{
+	return keysX.size() + unstoredCount;
+};
+
+bool UniqueVertexTable::isOverCap() const
+{
+	return bOverCap;
+};
+
+void UniqueVertexTable::clear()
+{
+	// a sparsely used large table would make clearing cost more than the next collections, drop it instead
+	if (slots.size() > initialSlotCount * 64 && keysX.size() < slots.size() / 8)
+	{
+		reset();
+		return;
+	}
+	std::fill(slots.begin(), slots.end(), 0);
+	keysX.clear();
+	keysY.clear();
+	keysZ.clear();
+	unstoredCount = 0;
+	bOverCap = false;
+};
+
+void UniqueVertexTable::reset()
+{
+	slots = {};
+	keysX = {};
+	keysY = {};
+	keysZ = {};
+	growThreshold = 0;
+	unstoredCount = 0;
+	bOverCap = false;
+	memoryBudget.release(reservedSize);
+	reservedSize = 0;
+};
+
+void UniqueVertexTable::swap(UniqueVertexTable& other)
+{
+	slots.swap(other.slots);
+	keysX.swap(other.keysX);
+	keysY.swap(other.keysY);
+	keysZ.swap(other.keysZ);
+	std::swap(growThreshold, other.growThreshold);
+	std::swap(reservedSize, other.reservedSize);
+	std::swap(unstoredCount, other.unstoredCount);
+	std::swap(bOverCap, other.bOverCap);
+};
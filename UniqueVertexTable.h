@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// memory shared by all unique vertex tables of a run, so concurrent files & their chunks stay within -uniquemem together
+class UniqueVertexMemoryBudget
+{
+	const uint64_t capacity;
+	std::atomic<uint64_t> reservedSize = 0;
+
+public:
+	explicit UniqueVertexMemoryBudget(uint64_t capacity);
+
+	UniqueVertexMemoryBudget(const UniqueVertexMemoryBudget&) = delete;
+	UniqueVertexMemoryBudget& operator=(const UniqueVertexMemoryBudget&) = delete;
+
+	// false if size doesn't fit in what is left
+	bool tryReserve(uint64_t size);
+	void release(uint64_t size);
+};
+
+// counts distinct vertex positions, exactly or welded within an epsilon
+// open addressing with linear probing, slots hold a hash tag & entry index so most probes never touch the coordinates,
+// coordinates are stored as quantized keys in separate per axis arrays
+class UniqueVertexTable
+{
+	// 0 = exact, else positions are snapped to a grid of this cell size before comparing
+	// NOTE: positions within epsilon of each other but on both sides of a cell border are not welded
+	const double weldEpsilon;
+	// slots & coordinate arrays are reserved from it before growing, see isOverCap()
+	UniqueVertexMemoryBudget& memoryBudget;
+	// bytes of memoryBudget held by this table
+	uint64_t reservedSize = 0;
+
+	// high 32 bits: hash tag, low 32 bits: entry index + 1, 0 = empty
+	std::vector<uint64_t> slots;
+	// 64 bit, welded cells of far apart positions don't fit 32 bits
+	std::vector<uint64_t> keysX;
+	std::vector<uint64_t> keysY;
+	std::vector<uint64_t> keysZ;
+	// entry count at which slots grow, 3/4 load
+	size_t growThreshold = 0;
+	// positions that could not be stored once over the memory cap, all assumed unique
+	uint64_t unstoredCount = 0;
+	bool bOverCap = false;
+
+	static constexpr size_t initialSlotCount = 1024;
+	// slot + 3/4 of an entry per slot
+	static constexpr uint64_t bytesPerSlot = sizeof(uint64_t) + 3 * sizeof(uint64_t) * 3 / 4;
+
+	inline uint64_t quantize(float value) const
+	{
+		if (weldEpsilon == 0)
+		{
+			// -0 & 0 are the same position
+			return value == 0 ? 0 : std::bit_cast<uint32_t>(value);
+		}
+		const double cell = std::floor(value / weldEpsilon + 0.5);
+		// inf, nan & cells out of int64 range are compared exactly,
+		// -2^63 + 32 bits is below -9e18 so it can't collide with a cell
+		if (!(std::abs(cell) < 9.0e18))
+		{
+			return 0x8000000000000000ull | std::bit_cast<uint32_t>(value);
+		}
+		return uint64_t(int64_t(cell));
+	}
+
+	static inline uint64_t hashKey(uint64_t x, uint64_t y, uint64_t z)
+	{
+		uint64_t hash = x * 0x9E3779B97F4A7C15ull;
+		hash = (hash ^ (hash >> 32) ^ y) * 0xFF51AFD7ED558CCDull;
+		hash = (hash ^ (hash >> 32) ^ z) * 0xC4CEB9FE1A85EC53ull;
+		return hash ^ (hash >> 32);
+	}
+
+	// false if the slots can't grow without exceeding memoryBudget
+	bool grow();
+	void insertKey(uint64_t x, uint64_t y, uint64_t z);
+
+public:
+	// memoryBudget must outlive the table
+	UniqueVertexTable(float weldEpsilon, UniqueVertexMemoryBudget& memoryBudget);
+	~UniqueVertexTable();
+
+	UniqueVertexTable(const UniqueVertexTable&) = delete;
+	UniqueVertexTable& operator=(const UniqueVertexTable&) = delete;
+
+	inline void insert(const std::array<float, 3>& position)
+	{
+		insertKey(quantize(position[0]), quantize(position[1]), quantize(position[2]));
+	}
+	// add all positions of other, which must use the same epsilon
+	void insertAll(const UniqueVertexTable& other);
+
+	// upper bound once over the memory cap
+	uint64_t getUniqueCount() const;
+	// set once a new position could not be stored
+	bool isOverCap() const;
+
+	// forget all positions, keeps allocations for the next collection
+	void clear();
+	// forget all positions & free the allocations for other tables of the run
+	void reset();
+	// exchange positions with other, which must use the same epsilon & budget
+	void swap(UniqueVertexTable& other);
+};
@@ -0,0 +1,50 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+	workers.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&WorkerPool::workerLoop, this);
+	}
+};
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard lock(queueMutex);
+		bIsStopping = true;
+	}
+	queueCondition.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+};
+
+uint32_t WorkerPool::getThreadCount() const
+{
+	return uint32_t(workers.size());
+};
+
+void WorkerPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock(queueMutex);
+			queueCondition.wait(lock, [this]() { return bIsStopping || !taskQueue.empty(); });
+
+			// only exit once queue is drained
+			if (taskQueue.empty())
+			{
+				return;
+			}
+			task = std::move(taskQueue.front());
+			taskQueue.pop_front();
+		}
+		task();
+	}
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// fixed size pool of worker threads executing queued tasks in submission order
+class WorkerPool
+{
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> taskQueue;
+	std::mutex queueMutex;
+	std::condition_variable queueCondition;
+	bool bIsStopping = false;
+
+	void workerLoop();
+
+public:
+	WorkerPool(uint32_t threadCount);
+	// finishes all queued tasks before joining
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	uint32_t getThreadCount() const;
+
+	// queue task, exceptions thrown by the task are rethrown by future.get()
+	template<typename Func>
+	std::future<std::invoke_result_t<Func>> submit(Func&& task);
+};
+
+template<typename Func>
+std::future<std::invoke_result_t<Func>> WorkerPool::submit(Func&& task)
+{
+	// std::function requires copyable callables, so share ownership of the packaged task
+	auto packagedTask = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(task));
+	std::future<std::invoke_result_t<Func>> result = packagedTask->get_future();
+	{
+		std::lock_guard lock(queueMutex);
+		taskQueue.emplace_back([packagedTask]() { (*packagedTask)(); });
+	}
+	queueCondition.notify_one();
+	return result;
+}